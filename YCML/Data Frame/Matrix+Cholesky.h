@@ -0,0 +1,41 @@
+//
+//  Matrix+Cholesky.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+@import YCMatrix;
+
+@interface Matrix (Cholesky)
+
+/**
+ Solves (A + lambda * I) X = B, where A is the symmetric receiver (NxN),
+ of which only the upper triangle is read, e.g. as accumulated by dsyrk.
+ The solution is found through a Cholesky factorization, falling back to
+ the pseudoinverse if the matrix is not numerically positive definite.
+ 
+ @param B      The right hand side (NxO).
+ @param lambda The value added to the diagonal of the receiver.
+ 
+ @return The solution X (NxO).
+ */
+- (Matrix *)matrixBySolvingSymmetric:(Matrix *)B regularization:(double)lambda;
+
+@end
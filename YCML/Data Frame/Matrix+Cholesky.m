@@ -0,0 +1,61 @@
+//
+//  Matrix+Cholesky.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "Matrix+Cholesky.h"
+@import Accelerate;
+
+@implementation Matrix (Cholesky)
+
+- (Matrix *)matrixBySolvingSymmetric:(Matrix *)B regularization:(double)lambda
+{
+    NSAssert(self->rows == self->columns && self->rows == B->rows, @"Matrix size mismatch");
+    int n = self->rows;
+    Matrix *A = [Matrix matrixFromMatrix:self];
+    for (int i=0; i<n; i++)
+    {
+        A->matrix[i * n + i] += lambda;
+    }
+    
+    // The row-major upper triangle is the column-major lower triangle;
+    // the right hand side is transposed to column-major
+    Matrix *X = [B matrixByTransposing];
+    char uplo = 'L';
+    __CLPK_integer N = n, nrhs = B->columns, info;
+    dpotrf_(&uplo, &N, A->matrix, &N, &info);
+    if (info == 0)
+    {
+        dpotrs_(&uplo, &N, &nrhs, A->matrix, &N, X->matrix, &N, &info);
+    }
+    if (info != 0)
+    {
+        Matrix *full = [Matrix matrixFromMatrix:self];
+        for (int i=0; i<n; i++)
+        {
+            full->matrix[i * n + i] += lambda;
+            for (int j=0; j<i; j++) full->matrix[i * n + j] = full->matrix[j * n + i];
+        }
+        return [[full pseudoInverse] matrixByMultiplyingWithRight:B];
+    }
+    return [X matrixByTransposing];
+}
+
+@end
@@ -0,0 +1,41 @@
+//
+//  Matrix+Transform.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "Matrix+Transform.h"
+
+@implementation Matrix (Transform)
+
+- (Matrix *)matrixByInvertingRowWiseTransform
+{
+    NSAssert(self->columns == 2, @"Matrix size mismatch");
+    Matrix *transform = [Matrix matrixLike:self];
+    for (int i=0; i<self->rows; i++)
+    {
+        double a = self->matrix[2*i];
+        double b = self->matrix[2*i + 1];
+        transform->matrix[2*i]     = 1.0 / a;
+        transform->matrix[2*i + 1] = -b / a;
+    }
+    return transform;
+}
+
+@end
@@ -22,7 +22,7 @@
 
 @import Foundation;
 #import "YCDataframe.h"
-@class Matrix;
+@class Matrix, YCSparseMatrix;
 
 @interface YCDataframe (Matrix)
 
@@ -30,6 +30,14 @@
 
 - (Matrix *)getMatrixUsingConversionArray:(NSArray *)conversionArray;
 
+/**
+ Sparse counterpart of getMatrixUsingConversionArray:. Categorical
+ attributes contribute a single non-zero element per sample, and zero
+ ordinal values are not stored, so that wide one-hot encodings can be
+ converted without materializing the dense matrix.
+ */
+- (YCSparseMatrix *)getSparseMatrixUsingConversionArray:(NSArray *)conversionArray;
+
 - (NSArray *)conversionArray;
 
 - (void)setDataWithMatrix:(Matrix *)inputMatrix conversionArray:(NSArray *)conversionArray;
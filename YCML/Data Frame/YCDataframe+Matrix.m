@@ -26,6 +26,7 @@
 #import "YCDataframe+Matrix.h"
 #import "OrderedDictionary.h"
 #import "YCMutableArray.h"
+#import "YCSparseMatrix.h"
 @import YCMatrix;
 
 @implementation YCDataframe (Matrix)
@@ -86,6 +87,100 @@
     return convertedMatrix;
 }
 
+- (YCSparseMatrix *)getSparseMatrixUsingConversionArray:(NSArray *)conversionArray
+{
+    NSUInteger sampleCount = [self dataCount];
+    if (sampleCount == 0) return nil;
+    int S = (int)sampleCount;
+    
+    // First pass: row offset of each element and non-zero count per sample
+    int rows = 0;
+    int *offsets = malloc(conversionArray.count * sizeof(int));
+    int *starts = calloc(S + 1, sizeof(int));
+    for (NSUInteger e=0; e<conversionArray.count; e++)
+    {
+        id element = conversionArray[e];
+        NSAssert([element isKindOfClass:[NSString class]] ||
+                 [element isKindOfClass:[NSDictionary class]],
+                 @"Conversion array element is neither String or Dictionary");
+        offsets[e] = rows;
+        if ([element isKindOfClass:[NSString class]])
+        {
+            int iter = 0;
+            for (id val in [self arrayReferenceForAttribute:element])
+            {
+                if ([val doubleValue] != 0) starts[iter + 1]++;
+                iter++;
+            }
+            rows++;
+        }
+        else
+        {
+            NSOrderedSet *classes = element[@"classes"];
+            int iter = 0;
+            for (id class in [self->_data objectForKey:element[@"label"]])
+            {
+                if ([classes containsObject:class]) starts[iter + 1]++;
+                iter++;
+            }
+            rows += (int)classes.count;
+        }
+    }
+    for (int j=0; j<S; j++) starts[j + 1] += starts[j];
+    
+    // Second pass: fill, in increasing row order within each sample
+    int nnz = starts[S];
+    int *fill = malloc(S * sizeof(int));
+    memcpy(fill, starts, S * sizeof(int));
+    int *rowIndexes = malloc(MAX(nnz, 1) * sizeof(int));
+    double *values = malloc(MAX(nnz, 1) * sizeof(double));
+    for (NSUInteger e=0; e<conversionArray.count; e++)
+    {
+        id element = conversionArray[e];
+        if ([element isKindOfClass:[NSString class]])
+        {
+            int iter = 0;
+            for (id val in [self arrayReferenceForAttribute:element])
+            {
+                double v = [val doubleValue];
+                if (v != 0)
+                {
+                    rowIndexes[fill[iter]] = offsets[e];
+                    values[fill[iter]++] = v;
+                }
+                iter++;
+            }
+        }
+        else
+        {
+            NSOrderedSet *classes = element[@"classes"];
+            int iter = 0;
+            for (id class in [self->_data objectForKey:element[@"label"]])
+            {
+                NSUInteger index = [classes indexOfObject:class];
+                if (index != NSNotFound)
+                {
+                    rowIndexes[fill[iter]] = offsets[e] + (int)index;
+                    values[fill[iter]++] = 1;
+                }
+                iter++;
+            }
+        }
+    }
+    
+    YCSparseMatrix *result = [[YCSparseMatrix alloc] initWithRows:rows
+                                                          columns:S
+                                                     columnStarts:starts
+                                                       rowIndexes:rowIndexes
+                                                           values:values];
+    free(offsets);
+    free(starts);
+    free(fill);
+    free(rowIndexes);
+    free(values);
+    return result;
+}
+
 - (NSArray *)conversionArray
 {
     NSMutableArray *conversionArray = [NSMutableArray array];
@@ -0,0 +1,71 @@
+//
+//  YCEpochIterator.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+@class Matrix;
+
+/**
+ Iterates over the columns (samples) of one or more matrices in shuffled
+ minibatches. The samples are permuted once per epoch and gathered into a
+ batch-blocked buffer, so that every minibatch is a contiguous block and
+ can be handed out as a view without further copying. All matrices share
+ the same permutation, so that e.g. corresponding input and output samples
+ stay together.
+ 
+ When the number of samples is not a multiple of the batch size, the
+ remaining samples of an epoch are left out; since the permutation
+ changes every epoch, no sample is permanently excluded.
+ */
+@interface YCEpochIterator : NSObject
+
+/**
+ Initializes an iterator over the columns of the passed matrices.
+ 
+ @param matrices  The matrices to iterate over. All must have the same number of columns.
+ @param batchSize The number of columns in each batch.
+ 
+ @return The iterator.
+ */
+- (instancetype)initWithMatrices:(NSArray *)matrices batchSize:(int)batchSize;
+
+/**
+ Returns the next minibatch, one matrix per source matrix, reshuffling
+ the data when an epoch is complete. The returned matrices are views of
+ the iterator's internal buffer and remain valid until the iterator next
+ reshuffles, i.e. for batchCount subsequent calls.
+ 
+ @return An NSArray of batchSize-column matrices.
+ */
+- (NSArray *)nextBatch;
+
+/**
+ Starts a new epoch with a fresh permutation.
+ */
+- (void)shuffle;
+
+@property (readonly) int batchSize;
+
+@property (readonly) int batchCount;
+
+@property (readonly) int epoch;
+
+@end
@@ -0,0 +1,127 @@
+//
+//  YCEpochIterator.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCEpochIterator.h"
+
+@implementation YCEpochIterator
+{
+    NSArray *_sources;
+    NSArray *_buffers;       // One (rows x batchCount*batchSize) buffer per source
+    NSArray *_batches;       // batchCount arrays of views into the buffers
+    vDSP_Length *_indexes;   // Permutation of sample indexes (one-based, for vDSP)
+    int _sampleCount;
+    int _next;
+}
+
+- (instancetype)initWithMatrices:(NSArray *)matrices batchSize:(int)batchSize
+{
+    self = [super init];
+    if (self)
+    {
+        _sources     = [matrices copy];
+        _sampleCount = ((Matrix *)matrices[0])->columns;
+        _batchSize   = MAX(1, MIN(batchSize, _sampleCount));
+        _batchCount  = _sampleCount / _batchSize;
+        _indexes     = malloc(_sampleCount * sizeof(vDSP_Length));
+        for (int i=0; i<_sampleCount; i++) _indexes[i] = i + 1;
+        
+        // Batch b of a source with R rows occupies the contiguous block
+        // [b*R*B, (b+1)*R*B) of its buffer, in row-major R x B layout
+        NSMutableArray *buffers = [NSMutableArray array];
+        NSMutableArray *batches = [NSMutableArray array];
+        for (int b=0; b<_batchCount; b++) [batches addObject:[NSMutableArray array]];
+        for (Matrix *source in _sources)
+        {
+            NSAssert(source->columns == _sampleCount, @"Matrices must have the same number of columns");
+            int rows = source->rows;
+            Matrix *buffer = [Matrix matrixOfRows:rows columns:_batchCount * _batchSize];
+            [buffers addObject:buffer];
+            for (int b=0; b<_batchCount; b++)
+            {
+                [batches[b] addObject:[Matrix matrixFromArray:buffer->matrix + b * rows * _batchSize
+                                                         rows:rows
+                                                      columns:_batchSize
+                                                         mode:YCMWeak]];
+            }
+        }
+        _buffers = buffers;
+        _batches = batches;
+        _epoch   = 0;
+        _next    = _batchCount; // Shuffle on first request
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_indexes);
+}
+
+- (NSArray *)nextBatch
+{
+    @synchronized(self)
+    {
+        if (_next >= _batchCount)
+        {
+            [self shuffle];
+        }
+        return _batches[_next++];
+    }
+}
+
+- (void)shuffle
+{
+    @synchronized(self)
+    {
+        // Fisher-Yates on the index buffer
+        for (int i=_sampleCount-1; i>0; i--)
+        {
+            int j = arc4random_uniform(i + 1);
+            vDSP_Length t = _indexes[i];
+            _indexes[i] = _indexes[j];
+            _indexes[j] = t;
+        }
+        
+        // Gather each row of each source into the batch-blocked buffers
+        for (int s=0, sc=(int)_sources.count; s<sc; s++)
+        {
+            Matrix *source = _sources[s];
+            Matrix *buffer = _buffers[s];
+            int rows = source->rows;
+            for (int b=0; b<_batchCount; b++)
+            {
+                double *block = buffer->matrix + b * rows * _batchSize;
+                for (int r=0; r<rows; r++)
+                {
+                    vDSP_vgathrD(source->matrix + r * _sampleCount, _indexes + b * _batchSize, 1,
+                                 block + r * _batchSize, 1, _batchSize);
+                }
+            }
+        }
+        _next = 0;
+        _epoch++;
+    }
+}
+
+@end
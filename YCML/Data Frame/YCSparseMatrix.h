@@ -0,0 +1,92 @@
+//
+//  YCSparseMatrix.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+@class Matrix;
+
+/**
+ An immutable sparse matrix in compressed sparse column (CSC) format.
+ Columns correspond to samples, as with Matrix inputs throughout YCML,
+ so that the non-zero elements of each sample are stored contiguously.
+ Suitable for wide inputs such as one-hot encoded categorical attributes.
+ */
+@interface YCSparseMatrix : NSObject <NSCopying>
+
+/**
+ Returns a sparse matrix containing the non-zero elements of |matrix|.
+ */
++ (instancetype)sparseMatrixWithMatrix:(Matrix *)matrix;
+
+/**
+ Initializes a sparse matrix by copying the passed CSC arrays.
+ 
+ @param rows         The number of rows.
+ @param columns      The number of columns.
+ @param columnStarts Offsets of the first element of each column (columns + 1).
+ @param rowIndexes   The row index of each non-zero element.
+ @param values       The value of each non-zero element.
+ 
+ @return The sparse matrix.
+ */
+- (instancetype)initWithRows:(int)rows
+                     columns:(int)columns
+                columnStarts:(const int *)columnStarts
+                  rowIndexes:(const int *)rowIndexes
+                      values:(const double *)values;
+
+/**
+ Returns a dense copy of the receiver.
+ */
+- (Matrix *)denseMatrix;
+
+/**
+ Returns a sparse matrix containing the columns at |indexes|.
+ */
+- (YCSparseMatrix *)sparseMatrixWithColumns:(NSIndexSet *)indexes;
+
+/**
+ Returns a scaling transform (rows x 2, in the format used by
+ Matrix -matrixByRowWiseMapUsing:) that maps the standard deviation
+ of each row to the same range as a StDev-based mapping to [0, 1],
+ without centering, so that zero elements remain zero.
+ */
+- (Matrix *)rowWiseScalingTransform;
+
+/**
+ Returns a copy of the receiver with each row multiplied by the first
+ column of |transform|. The offset column is ignored.
+ */
+- (YCSparseMatrix *)sparseMatrixByRowWiseScaling:(Matrix *)transform;
+
+@property (readonly) int rows;
+
+@property (readonly) int columns;
+
+@property (readonly) int nonZeroCount;
+
+@property (readonly) const int *columnStarts;
+
+@property (readonly) const int *rowIndexes;
+
+@property (readonly) const double *values;
+
+@end
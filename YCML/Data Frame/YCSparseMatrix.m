@@ -0,0 +1,193 @@
+//
+//  YCSparseMatrix.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+#import "YCSparseMatrix.h"
+
+@implementation YCSparseMatrix
+{
+    int *_starts;
+    int *_indexes;
+    double *_values;
+}
+
++ (instancetype)sparseMatrixWithMatrix:(Matrix *)matrix
+{
+    int m = matrix->rows;
+    int n = matrix->columns;
+    int *starts = malloc((n + 1) * sizeof(int));
+    int nnz = 0;
+    for (int i=0, count=m*n; i<count; i++)
+    {
+        if (matrix->matrix[i] != 0) nnz++;
+    }
+    int *indexes = malloc(MAX(nnz, 1) * sizeof(int));
+    double *values = malloc(MAX(nnz, 1) * sizeof(double));
+    int k = 0;
+    for (int j=0; j<n; j++)
+    {
+        starts[j] = k;
+        for (int i=0; i<m; i++)
+        {
+            double v = matrix->matrix[i * n + j];
+            if (v == 0) continue;
+            indexes[k] = i;
+            values[k++] = v;
+        }
+    }
+    starts[n] = k;
+    YCSparseMatrix *result = [[self alloc] initWithRows:m columns:n
+                                           columnStarts:starts rowIndexes:indexes values:values];
+    free(starts);
+    free(indexes);
+    free(values);
+    return result;
+}
+
+- (instancetype)initWithRows:(int)rows
+                     columns:(int)columns
+                columnStarts:(const int *)columnStarts
+                  rowIndexes:(const int *)rowIndexes
+                      values:(const double *)values
+{
+    self = [super init];
+    if (self)
+    {
+        _rows         = rows;
+        _columns      = columns;
+        _nonZeroCount = columnStarts[columns];
+        _starts       = malloc((columns + 1) * sizeof(int));
+        _indexes      = malloc(MAX(_nonZeroCount, 1) * sizeof(int));
+        _values       = malloc(MAX(_nonZeroCount, 1) * sizeof(double));
+        memcpy(_starts, columnStarts, (columns + 1) * sizeof(int));
+        memcpy(_indexes, rowIndexes, _nonZeroCount * sizeof(int));
+        memcpy(_values, values, _nonZeroCount * sizeof(double));
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    free(_starts);
+    free(_indexes);
+    free(_values);
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Immutable
+    return self;
+}
+
+- (const int *)columnStarts
+{
+    return _starts;
+}
+
+- (const int *)rowIndexes
+{
+    return _indexes;
+}
+
+- (const double *)values
+{
+    return _values;
+}
+
+- (Matrix *)denseMatrix
+{
+    Matrix *result = [Matrix matrixOfRows:_rows columns:_columns];
+    for (int j=0; j<_columns; j++)
+    {
+        for (int k=_starts[j]; k<_starts[j+1]; k++)
+        {
+            result->matrix[_indexes[k] * _columns + j] = _values[k];
+        }
+    }
+    return result;
+}
+
+- (YCSparseMatrix *)sparseMatrixWithColumns:(NSIndexSet *)indexes
+{
+    int n = (int)indexes.count;
+    int *starts = malloc((n + 1) * sizeof(int));
+    __block int nnz = 0;
+    __block int j = 0;
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        starts[j++] = nnz;
+        nnz += self->_starts[idx + 1] - self->_starts[idx];
+    }];
+    starts[n] = nnz;
+    int *rowIndexes = malloc(MAX(nnz, 1) * sizeof(int));
+    double *values = malloc(MAX(nnz, 1) * sizeof(double));
+    j = 0;
+    [indexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL *stop) {
+        int length = self->_starts[idx + 1] - self->_starts[idx];
+        memcpy(rowIndexes + starts[j], self->_indexes + self->_starts[idx], length * sizeof(int));
+        memcpy(values + starts[j], self->_values + self->_starts[idx], length * sizeof(double));
+        j++;
+    }];
+    YCSparseMatrix *result = [[YCSparseMatrix alloc] initWithRows:_rows columns:n
+                                                     columnStarts:starts
+                                                       rowIndexes:rowIndexes
+                                                           values:values];
+    free(starts);
+    free(rowIndexes);
+    free(values);
+    return result;
+}
+
+- (Matrix *)rowWiseScalingTransform
+{
+    // Zero elements contribute to the moments without being stored
+    Matrix *sums    = [Matrix matrixOfRows:_rows columns:1];
+    Matrix *squares = [Matrix matrixOfRows:_rows columns:1];
+    for (int k=0; k<_nonZeroCount; k++)
+    {
+        sums->matrix[_indexes[k]]    += _values[k];
+        squares->matrix[_indexes[k]] += _values[k] * _values[k];
+    }
+    Matrix *transform = [Matrix matrixOfRows:_rows columns:2];
+    for (int i=0; i<_rows; i++)
+    {
+        double mean = sums->matrix[i] / _columns;
+        double variance = MAX(squares->matrix[i] / _columns - mean * mean, 0);
+        double range = 2 * sqrt(variance);
+        [transform i:i j:0 set:range > 0 ? 1.0 / range : 1.0];
+    }
+    return transform;
+}
+
+- (YCSparseMatrix *)sparseMatrixByRowWiseScaling:(Matrix *)transform
+{
+    YCSparseMatrix *result = [[YCSparseMatrix alloc] initWithRows:_rows columns:_columns
+                                                     columnStarts:_starts
+                                                       rowIndexes:_indexes
+                                                           values:_values];
+    for (int k=0; k<_nonZeroCount; k++)
+    {
+        result->_values[k] *= transform->matrix[2 * _indexes[k]];
+    }
+    return result;
+}
+
+@end
@@ -21,7 +21,36 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 #import "YCSupervisedTrainer.h"
+@class YCFFN;
 
+/**
+ Extreme Learning Machine trainer. The hidden layer output is never
+ materialized for the whole dataset: samples are propagated in column
+ chunks of "Chunk Size", and only the H x H and H x O terms of the
+ regularized normal equations are accumulated, so that peak memory is
+ independent of the number of samples. The accumulated terms are kept by
+ the receiver, so that the last model it trained can be updated with new
+ data (online sequential ELM), without revisiting earlier samples.
+ */
 @interface YCELMTrainer : YCSupervisedTrainer
 
+/**
+ Updates the output weights of the model last trained by the receiver,
+ with additional samples. The result is identical to training with all
+ samples at once, except that the input and output transforms are those
+ determined from the initial training data. Datasets larger than memory
+ may thus be trained in parts, by training with the first part and
+ updating with the rest.
+ 
+ @param model  The model last trained by the receiver.
+ @param input  The additional input (NxS).
+ @param output The additional output (OxS).
+ */
+- (void)updateModel:(YCFFN *)model inputMatrix:(Matrix *)input outputMatrix:(Matrix *)output;
+
+/**
+ Returns the number of samples accumulated for the last trained model.
+ */
+@property (readonly) int accumulatedSampleCount;
+
 @end
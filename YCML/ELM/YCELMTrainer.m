@@ -47,9 +47,17 @@
 #import "YCFFN.h"
 #import "YCTanhLayer.h"
 #import "YCLinearLayer.h"
+#import "Matrix+Cholesky.h"
+#import "Matrix+Transform.h"
 @import YCMatrix;
+@import Accelerate;
 
 @implementation YCELMTrainer
+{
+    Matrix *_gram;         // H * H' (HxH, upper triangle), accumulated over all samples
+    Matrix *_projection;   // H * T' (HxO), accumulated over all samples
+    __weak YCFFN *_accumulatedModel;
+}
 
 + (Class)modelClass
 {
@@ -63,6 +71,7 @@
     {
         self.settings[@"Hidden Layer Size"] = @800;
         self.settings[@"C"]                 = @1;
+        self.settings[@"Chunk Size"]        = @1000;
     }
     return self;
 }
@@ -80,16 +89,12 @@
     int inputSize             = input.rows;
     int outputSize            = output.rows;
     int hiddenSize            = [self.settings[@"Hidden Layer Size"] intValue];
-    double C                  = [self.settings[@"C"] doubleValue];
-    Matrix *inputTransform  = [input rowWiseMapToDomain:domain basis:StDev];
     
-    // Step I. Scaling inputs & outputs; determining inverse output scaling matrix
-    Matrix *outputTransform = [output rowWiseMapToDomain:domain basis:MinMax];
+    // Step I. Determining input & output scaling matrices
+    Matrix *inputTransform  = [input rowWiseMapToDomain:domain basis:StDev];
     Matrix *invOutTransform = [output rowWiseInverseMapFromDomain:domain basis:MinMax];
-    Matrix *scaledInput     = [input matrixByRowWiseMapUsing:inputTransform];
-    Matrix *scaledOutput    = [output matrixByRowWiseMapUsing:outputTransform];
     
-    // Step II. Randomized input weights and biases and calculation of hidden layer output
+    // Step II. Randomized input weights and biases
     YCTanhLayer *hiddenLayer = [[YCTanhLayer alloc] initWithInputSize:inputSize
                                                            outputSize:hiddenSize];
     hiddenLayer.weightMatrix = [Matrix uniformRandomRows:inputSize
@@ -100,32 +105,86 @@
                                                columns:1
                                                 domain:hiddenDomain];
     
-    Matrix *H = [hiddenLayer forward:scaledInput];
-    
-    // Step III. Calculating output weights
-    // outW = ( eye(nHiddenNeurons)/C + H * H') \ H * targets';
-    Matrix *oneOverC      = [Matrix identityOfRows:hiddenSize columns:hiddenSize];
-    [oneOverC multiplyWithScalar:1.0/C];
-    [oneOverC add:[H matrixByTransposingAndMultiplyingWithLeft:H]];
-    Matrix *invA          = [oneOverC pseudoInverse];
-    
-    Matrix *HTargetsT     = [scaledOutput matrixByTransposingAndMultiplyingWithLeft:H];
-    Matrix *outputWeights = [invA matrixByMultiplyingWithRight:HTargetsT];
-    
-    Matrix *outputBiases  = [Matrix matrixOfRows:outputSize columns:1];
-    
     YCLinearLayer *outputLayer = [[YCLinearLayer alloc] initWithInputSize:hiddenSize
                                                                outputSize:outputSize];
-    outputLayer.weightMatrix = outputWeights;
-    outputLayer.biasVector = outputBiases;
     
     model.layers = @[hiddenLayer, outputLayer];
     
-    // Step IV. Copy transform matrices to model
-    // TRANSFORM MATRICES SHOULD BE COPIED AFTER TRAINING OTHERWISE
-    // THE MODEL WILL SCALE OUTPUTS AND RETURN FALSE ERRORS
+    // Step III. Copy transform matrices to model; they are only used for
+    // scaling new samples from now on, as the output weights are solved for
     model.inputTransform      = inputTransform;
     model.outputTransform     = invOutTransform;
+    
+    // Step IV. Accumulating the normal equations and calculating output weights
+    _gram                     = [Matrix matrixOfRows:hiddenSize columns:hiddenSize];
+    _projection               = [Matrix matrixOfRows:hiddenSize columns:outputSize];
+    _accumulatedSampleCount   = 0;
+    _accumulatedModel         = model;
+    [self accumulateModel:model inputMatrix:input outputMatrix:output];
+}
+
+- (void)updateModel:(YCFFN *)model inputMatrix:(Matrix *)input outputMatrix:(Matrix *)output
+{
+    NSAssert(model && model == _accumulatedModel, @"Model was not last trained by the receiver");
+    self.shouldStop = NO;
+    [self accumulateModel:model inputMatrix:input outputMatrix:output];
+}
+
+- (void)accumulateModel:(YCFFN *)model inputMatrix:(Matrix *)input outputMatrix:(Matrix *)output
+{
+    NSAssert(input.columns == output.columns, @"Sample count mismatch");
+    
+    YCTanhLayer *hiddenLayer   = model.layers[0];
+    YCLinearLayer *outputLayer = model.layers[1];
+    int S                      = input.columns;
+    int chunkSize              = MAX(1, [self.settings[@"Chunk Size"] intValue]);
+    double C                   = [self.settings[@"C"] doubleValue];
+    
+    // Forward output transform, from the model's inverse one
+    Matrix *outputTransform    = [model.outputTransform matrixByInvertingRowWiseTransform];
+    
+    // Accumulating H * H' (upper triangle) and H * T' chunk by chunk
+    int hiddenSize  = hiddenLayer.outputSize;
+    int O           = outputLayer.outputSize;
+    int sliceCount  = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+    Matrix *H       = [Matrix matrixOfRows:hiddenSize columns:MIN(chunkSize, S)];
+    for (int c0=0; c0<S; c0+=chunkSize)
+    {
+        if (self.shouldStop)
+        {
+            // The accumulated terms are incomplete, and can't be updated further
+            _accumulatedModel = nil;
+            return;
+        }
+        NSRange range = NSMakeRange(c0, MIN(chunkSize, S - c0));
+        int c = (int)range.length;
+        Matrix *scaledInput  = [[input matrixWithColumnsInRange:range]
+                                matrixByRowWiseMapUsing:model.inputTransform];
+        Matrix *scaledOutput = [[output matrixWithColumnsInRange:range]
+                                matrixByRowWiseMapUsing:outputTransform];
+        
+        // Hidden layer output, in parallel column slices of the chunk
+        int slice = MAX(32, (c + sliceCount - 1) / sliceCount);
+        double *x = scaledInput->matrix;
+        double *h = H->matrix;
+        dispatch_apply((c + slice - 1) / slice,
+                       dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+            int s0 = (int)i * slice;
+            [hiddenLayer forwardValues:x + s0 stride:c
+                                  into:h + s0 stride:c
+                               columns:MIN(slice, c - s0)];
+        });
+        
+        cblas_dsyrk(CblasRowMajor, CblasUpper, CblasNoTrans, hiddenSize, c,
+                    1.0, h, c, 1.0, _gram->matrix, hiddenSize);
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, hiddenSize, O, c,
+                    1.0, h, c, scaledOutput->matrix, c, 1.0, _projection->matrix, O);
+    }
+    _accumulatedSampleCount += S;
+    
+    // outW = ( eye(nHiddenNeurons)/C + H * H') \ H * targets';
+    outputLayer.weightMatrix = [_gram matrixBySolvingSymmetric:_projection regularization:1.0/C];
+    outputLayer.biasVector   = [Matrix matrixOfRows:O columns:1];
 }
 
 @end
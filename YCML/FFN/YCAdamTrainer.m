@@ -0,0 +1,46 @@
+//
+//  YCAdamTrainer.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCAdamTrainer.h"
+#import "YCAdam.h"
+
+@implementation YCAdamTrainer
+
++ (Class)optimizerClass
+{
+    return [YCAdam class];
+}
+
+-(id)init
+{
+    if (self = [super init])
+    {
+        self.settings[@"Iterations"]    = @2000;
+        self.settings[@"Learning Rate"] = @0.01;
+        self.settings[@"Schedule"]      = @"Cosine";
+        self.settings[@"Samples"]       = @32;
+        [self.settings removeObjectForKey:@"Alpha"];
+    }
+    return self;
+}
+
+@end
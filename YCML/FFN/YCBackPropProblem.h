@@ -23,7 +23,7 @@
 @import Foundation;
 #import "YCDerivativeProblem.h"
 
-@class YCFFN;
+@class YCFFN, YCSparseMatrix;
 
 @interface YCBackPropProblem : NSObject <YCDerivativeProblem>
 {
@@ -31,22 +31,72 @@
     NSArray *_inputMatrixArray;
     Matrix *_outputMatrix;
     NSArray *_outputMatrixArray;
+    YCSparseMatrix *_sparseInputMatrix;
 }
 
 - (instancetype)initWithInputMatrix:(Matrix *)input
                        outputMatrix:(Matrix *)output
                               model:(YCFFN *)model;
 
+/**
+ Initializes a problem whose input is sparse, e.g. one-hot encoded
+ categorical attributes. The first layer's forward pass and weight
+ gradients are computed only over the non-zero input elements.
+ The single precision path is not used with sparse inputs.
+ 
+ @param input  The sparse input matrix (NxS).
+ @param output The output matrix (OxS).
+ @param model  The model to be trained.
+ 
+ @return The problem.
+ */
+- (instancetype)initWithSparseInputMatrix:(YCSparseMatrix *)input
+                             outputMatrix:(Matrix *)output
+                                    model:(YCFFN *)model;
+
 - (NSArray *)modelWeightsWithParameters:(Matrix *)parameters;
 
 - (NSArray *)modelBiasesWithParameters:(Matrix *)parameters;
 
 - (void)storeWeights:(NSArray *)weights biases:(NSArray *)biases toVector:(Matrix *)vector;
 
+/**
+ The number of weight parameters, which precede the bias parameters in
+ the parameter vector.
+ */
+- (int)weightParameterCount;
+
 @property YCFFN *trainedModel;
 
 @property int sampleCount;
 
 @property int batchSize;
 
+/**
+ When set, -derivatives:parameters: runs the forward and backward passes
+ in single precision, while parameters remain in double precision and
+ gradients are accumulated in double precision across batches. If the
+ single precision gradients are not finite, or the deltas underflow,
+ the computation is repeated in double precision.
+ */
+@property BOOL singlePrecision;
+
+/**
+ The number of times the single precision path fell back to double precision.
+ */
+@property (readonly) int doublePrecisionFallbacks;
+
+/**
+ When set, optimization starts from these parameters (Px1) rather than
+ from random values, e.g. to retune an already trained model.
+ */
+@property Matrix *initialParameters;
+
+/**
+ When set, the derivatives are multiplied element-wise with this mask
+ (Px1), so that parameters whose mask value is zero remain unchanged by
+ gradient-based optimizers, e.g. to keep pruned weights at zero.
+ */
+@property Matrix *parameterMask;
+
 @end
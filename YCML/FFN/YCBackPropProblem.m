@@ -21,8 +21,11 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 @import YCMatrix;
+@import Accelerate;
 #import "YCBackPropProblem.h"
 #import "YCFFN.h"
+#import "YCEpochIterator.h"
+#import "YCSparseMatrix.h"
 #import "NSIndexSet+Sampling.h"
 #import "YCFullyConnectedLayer.h"
 
@@ -32,6 +35,12 @@
 // O: Size of output
 
 @implementation YCBackPropProblem
+{
+    NSArray *_layers;
+    YCEpochIterator *_epochIterator;
+    NSMutableData *_singleInput;
+    NSMutableData *_singleOutput;
+}
 
 - (instancetype)initWithInputMatrix:(Matrix *)input
                        outputMatrix:(Matrix *)output
@@ -42,14 +51,31 @@
     {
         self->_inputMatrix = input;
         self->_outputMatrix = output;
-        self->_trainedModel = model;
+        self.trainedModel = model;
         self.batchSize = 1; // Default, single sample, will be probably overriden by trainer
     }
     return self;
 }
 
+- (instancetype)initWithSparseInputMatrix:(YCSparseMatrix *)input
+                             outputMatrix:(Matrix *)output
+                                    model:(YCFFN *)model
+{
+    self = [self initWithInputMatrix:nil outputMatrix:output model:model];
+    if (self)
+    {
+        self->_sparseInputMatrix = input;
+    }
+    return self;
+}
+
 - (Matrix *)initialValuesRangeHint
 {
+    if (self.initialParameters)
+    {
+        // A degenerate range, so that the optimizer starts from the given parameters
+        return [self.initialParameters appendColumn:self.initialParameters];
+    }
     int parameterCount = [self parameterCount];
     Matrix *minValues = [Matrix matrixOfRows:parameterCount columns:1 value:-0.1];
     Matrix *maxValues = [Matrix matrixOfRows:parameterCount columns:1 value:0.1];
@@ -61,95 +87,165 @@
     return nil;
 }
 
-- (void)evaluate:(Matrix *)target parameters:(Matrix *)parameters
+- (void)setTrainedModel:(YCFFN *)trainedModel
+{
+    _trainedModel = trainedModel;
+    _layers = nil;
+}
+
+// The problem works on private copies of the model layers, so that the
+// trained model can keep serving activations while parameters are
+// being evaluated. Final parameters are copied to the model by the trainer.
+- (NSArray *)layersWithParameters:(Matrix *)parameters
 {
+    if (!_layers)
+    {
+        _layers = [[NSArray alloc] initWithArray:self.trainedModel.layers copyItems:YES];
+    }
     NSArray *weights = [self modelWeightsWithParameters:parameters];
     NSArray *biases  = [self modelBiasesWithParameters:parameters];
-    NSAssert(weights.count == self.trainedModel.layers.count, @"Weights and layers counts mismatch");
-    NSAssert(biases.count == self.trainedModel.layers.count, @"Biases and layers counts mismatch");
-    [self.trainedModel.layers enumerateObjectsUsingBlock:^(id  _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
+    NSAssert(weights.count == _layers.count, @"Weights and layers counts mismatch");
+    NSAssert(biases.count == _layers.count, @"Biases and layers counts mismatch");
+    [_layers enumerateObjectsUsingBlock:^(id  _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
         YCFullyConnectedLayer *layer = obj;
         layer.weightMatrix = weights[idx];
         layer.biasVector = biases[idx];
     }];
+    return _layers;
+}
+
+- (void)evaluate:(Matrix *)target parameters:(Matrix *)parameters
+{
+    NSArray *layers = [self layersWithParameters:parameters];
     
-    Matrix *residual = [self->_trainedModel activateWithMatrix:self->_inputMatrix];
+    Matrix *residual = self->_sparseInputMatrix ?
+    [layers[0] forwardSparse:self->_sparseInputMatrix] : [layers[0] forward:self->_inputMatrix];
+    for (NSUInteger l=1; l<layers.count; l++)
+    {
+        residual = [layers[l] forward:residual];
+    }
     
     // Calculate sum-of-squares error
-    [residual subtract:self->_outputMatrix];
+    residual = [residual matrixBySubtracting:self->_outputMatrix];
     [residual applyFunction:^double(double value) {
         return 0.5*value*value;
     }];
     
     // Calculate regularization term
     double r = 0;
-    for (YCFullyConnectedLayer *layer in self.trainedModel.layers)
+    for (YCFullyConnectedLayer *layer in layers)
     {
         r += [layer regularizationLoss];
     }
     
     // Add and return
-    double s = self->_inputMatrix.columns;
+    double s = self->_outputMatrix.columns;
     double cost = [residual sum] / (self.trainedModel.outputSize * s) + r/s;
     [target setValue:cost row:0 column:0];
 }
 
 - (void)derivatives:(Matrix *)derivatives parameters:(Matrix *)parameters
+{
+    [self unmaskedDerivatives:derivatives parameters:parameters];
+    if (self.parameterMask)
+    {
+        [derivatives elementWiseMultiply:self.parameterMask];
+    }
+}
+
+- (void)unmaskedDerivatives:(Matrix *)derivatives parameters:(Matrix *)parameters
 {
     // Layer numbering starts from ZERO, i.e. input layer is L0
-    YCFFN *tm = self.trainedModel;
     
     // Initialization
-    NSArray *weights = [self modelWeightsWithParameters:parameters];
-    NSArray *biases  = [self modelBiasesWithParameters:parameters];
-    NSAssert(weights.count == self.trainedModel.layers.count, @"Weights and layers counts mismatch");
-    NSAssert(biases.count == self.trainedModel.layers.count, @"Biases and layers counts mismatch");
-    [self.trainedModel.layers enumerateObjectsUsingBlock:^(id  _Nonnull obj, NSUInteger idx, BOOL * _Nonnull stop) {
-        YCFullyConnectedLayer *layer = obj;
-        layer.weightMatrix = weights[idx];
-        layer.biasVector = biases[idx];
-    }];
-    int hiddenCount   = tm.hiddenLayerCount;
+    NSArray *layers  = [self layersWithParameters:parameters];
+    NSArray *weights = [layers valueForKey:@"weightMatrix"];
+    NSArray *biases  = [layers valueForKey:@"biasVector"];
+    int hiddenCount  = (int)layers.count - 1;
     
     // Prepare Matrices and Arrays
     int exampleCount;
     Matrix *inputMatrix;
+    YCSparseMatrix *sparseInput;
     Matrix *outputMatrix;
     NSArray *inputMatrixArray;
     NSArray *outputMatrixArray;
     
-    if (self.sampleCount <= 0 || self.sampleCount > self->_inputMatrix->columns)
+    if (self.sampleCount <= 0 || self.sampleCount > self->_outputMatrix->columns)
     {
-        // Reference & Split matrices
-        exampleCount  = self->_inputMatrix->columns;
+        // Reference matrices
+        exampleCount  = self->_outputMatrix->columns;
         inputMatrix  = self->_inputMatrix;
+        sparseInput  = self->_sparseInputMatrix;
         outputMatrix = self->_outputMatrix;
-        if (!self->_inputMatrixArray) _inputMatrixArray   = [inputMatrix columnWisePartition:self.batchSize];
-        if (!self->_outputMatrixArray) _outputMatrixArray = [outputMatrix columnWisePartition:self.batchSize];
-        inputMatrixArray = _inputMatrixArray;
-        outputMatrixArray = _outputMatrixArray;
     }
-    else
+    else if (self->_sparseInputMatrix)
     {
-        // Sample & Split matrices
+        // Sample sparse columns; only their non-zero elements are copied
         exampleCount  = self.sampleCount;
-        NSRange range = NSMakeRange(0, self->_inputMatrix->columns);
+        NSRange range = NSMakeRange(0, self->_outputMatrix->columns);
         NSIndexSet *exampleIndexes = [NSIndexSet indexesForSampling:exampleCount
                                                             inRange:range
                                                         replacement:NO];
-        inputMatrix  = [self->_inputMatrix columns:exampleIndexes];
+        inputMatrix  = nil;
+        sparseInput  = [self->_sparseInputMatrix sparseMatrixWithColumns:exampleIndexes];
         outputMatrix = [self->_outputMatrix columns:exampleIndexes];
+    }
+    else
+    {
+        // Take the next minibatch of the current epoch
+        exampleCount  = self.sampleCount;
+        if (!_epochIterator || _epochIterator.batchSize != exampleCount)
+        {
+            _epochIterator = [[YCEpochIterator alloc] initWithMatrices:@[self->_inputMatrix,
+                                                                          self->_outputMatrix]
+                                                             batchSize:exampleCount];
+        }
+        NSArray *batch = [_epochIterator nextBatch];
+        inputMatrix  = batch[0];
+        sparseInput  = nil;
+        outputMatrix = batch[1];
+    }
+    
+    // Mixed precision path, falling back to double precision on failure
+    if (self.singlePrecision && !sparseInput)
+    {
+        if ([self singlePrecisionDerivatives:derivatives layers:layers
+                                       input:inputMatrix output:outputMatrix])
+        {
+            return;
+        }
+        _doublePrecisionFallbacks++;
+    }
+    
+    // Split matrices (sparse inputs are addressed by column range instead)
+    if (exampleCount <= self.batchSize)
+    {
+        inputMatrixArray  = inputMatrix ? @[inputMatrix] : nil;
+        outputMatrixArray = @[outputMatrix];
+    }
+    else if (outputMatrix == self->_outputMatrix)
+    {
+        if (inputMatrix && !self->_inputMatrixArray) _inputMatrixArray = [inputMatrix columnWisePartition:self.batchSize];
+        if (!self->_outputMatrixArray) _outputMatrixArray = [outputMatrix columnWisePartition:self.batchSize];
+        inputMatrixArray = _inputMatrixArray;
+        outputMatrixArray = _outputMatrixArray;
+    }
+    else
+    {
         inputMatrixArray  = [inputMatrix columnWisePartition:self.batchSize];
         outputMatrixArray = [outputMatrix columnWisePartition:self.batchSize];
     }
     
-    // Activate model and extract layer output arrays
-    [tm activateWithMatrix:inputMatrix];
-    
+    // Activate model layer-by-layer and split layer outputs
     NSMutableArray *activationArrays = [NSMutableArray array];
-    for (Matrix *m in [tm.layers valueForKey:@"lastActivation"])
+    Matrix *activation = inputMatrix;
+    for (YCFullyConnectedLayer *layer in layers)
     {
-        [activationArrays addObject:[m columnWisePartition:self.batchSize]];
+        activation = sparseInput && layer == layers[0] ?
+        [layer forwardSparse:sparseInput] : [layer forward:activation];
+        [activationArrays addObject:exampleCount <= self.batchSize ? @[activation] :
+         [activation columnWisePartition:self.batchSize]];
     }
     
     // Prepare weight and bias matrices
@@ -162,7 +258,7 @@
     }
     
     // For every example batch:
-    for (int b=0, count = (int)inputMatrixArray.count; b<count; b++)
+    for (int b=0, count = (int)outputMatrixArray.count; b<count; b++)
     {
         // Calculate Deltas for Output
         NSMutableArray *deltas = [NSMutableArray array];
@@ -170,7 +266,7 @@
         Matrix *modelOutput    = [activationArrays lastObject][b];
         
         Matrix *modelOutputGradient = [modelOutput copy];
-        [[tm.layers lastObject] activationFunctionGradient:modelOutputGradient];
+        [[layers lastObject] activationFunctionGradient:modelOutputGradient];
         
         Matrix *delta          = [modelOutput matrixBySubtracting:expectedOutput];
         [delta elementWiseMultiply:modelOutputGradient];
@@ -180,9 +276,9 @@
         // Calculate Deltas for Hidden Layers
         for (int l=hiddenCount; l>=1; l--)
         {
-            delta                   = [[tm.layers[l] weightMatrix] matrixByMultiplyingWithRight:delta];
+            delta                   = [weights[l] matrixByMultiplyingWithRight:delta];
             Matrix *layerDerivative = [activationArrays[l-1][b] copy];
-            [tm.layers[l-1] activationFunctionGradient:layerDerivative];
+            [layers[l-1] activationFunctionGradient:layerDerivative];
             [delta elementWiseMultiply:layerDerivative];
             [deltas insertObject:delta atIndex:0];
         }
@@ -190,28 +286,224 @@
         // Find Derivatives for each weight and bias
         for (int l=0; l<=hiddenCount; l++)
         {
-            Matrix *weights = [self.trainedModel.layers[l] weightMatrix];
-            Matrix *incoming = l==0 ? inputMatrixArray[b] : activationArrays[l-1][b];
             delta              = deltas[l];
-            Matrix *loss = [delta matrixByTransposingAndMultiplyingWithLeft:incoming];
-            [loss add:[weights matrixByMultiplyingWithScalar:[self.trainedModel.layers[l] L2]]];
-            [weightGradients[l] add:loss];
+            if (l == 0 && sparseInput)
+            {
+                NSRange columns = NSMakeRange(b * self.batchSize, delta.columns);
+                [layers[0] accumulateWeightGradients:weightGradients[0]
+                                         sparseInput:sparseInput
+                                             columns:columns
+                                              deltas:delta];
+            }
+            else
+            {
+                Matrix *incoming = l==0 ? inputMatrixArray[b] : activationArrays[l-1][b];
+                [weightGradients[l] add:[delta matrixByTransposingAndMultiplyingWithLeft:incoming]];
+            }
             
             [biasGradients[l] add:[delta sumsOfRows]];
         }
     }
     
-    // Divide gradients with sample count
-    double mult = 1.0/exampleCount;
-    for (Matrix *m in weightGradients)
+    [self scaleWeightGradients:weightGradients biasGradients:biasGradients
+                        layers:layers exampleCount:exampleCount];
+    [self storeWeights:weightGradients biases:biasGradients toVector:derivatives];
+}
+
+// Brings the accumulated error gradients in line with the cost returned by
+// -evaluate:parameters:, sum(0.5 r^2)/(O*S) + sum(L2 |W|^2)/S, by dividing
+// them with O*S and adding the regularization gradient 2 L2 W/S
+- (void)scaleWeightGradients:(NSArray *)weightGradients
+               biasGradients:(NSArray *)biasGradients
+                      layers:(NSArray *)layers
+                exampleCount:(int)exampleCount
+{
+    double mult = 1.0/(self.trainedModel.outputSize * exampleCount);
+    for (int l=0, count=(int)layers.count; l<count; l++)
+    {
+        YCFullyConnectedLayer *layer = layers[l];
+        Matrix *wg = weightGradients[l];
+        [wg multiplyWithScalar:mult];
+        if (layer.L2 != 0)
+        {
+            [wg add:[layer.weightMatrix matrixByMultiplyingWithScalar:2 * layer.L2 / exampleCount]];
+        }
+        [biasGradients[l] multiplyWithScalar:mult];
+    }
+}
+
+// Single precision forward and backward passes. Activations and deltas
+// are kept in float32 for the whole example set, while weight and bias
+// gradients are reduced per batch and accumulated in float64, reproducing
+// the double precision path. Returns NO,
+// without touching |derivatives|, if the result cannot be trusted.
+- (BOOL)singlePrecisionDerivatives:(Matrix *)derivatives
+                            layers:(NSArray *)layers
+                             input:(Matrix *)input
+                            output:(Matrix *)output
+{
+    int S = input->columns;
+    int L = (int)layers.count;
+    int B = MAX(1, MIN(self.batchSize, S));
+    int batchCount = (S + B - 1) / B;
+    
+    // Inputs & outputs; converted once when training on the full set
+    const float *x;
+    const float *y;
+    NSMutableData *inputData, *outputData;
+    if (input == self->_inputMatrix && _singleInput)
+    {
+        inputData  = _singleInput;
+        outputData = _singleOutput;
+    }
+    else
+    {
+        inputData  = [NSMutableData dataWithLength:input.count * sizeof(float)];
+        outputData = [NSMutableData dataWithLength:output.count * sizeof(float)];
+        vDSP_vdpsp(input->matrix, 1, inputData.mutableBytes, 1, input.count);
+        vDSP_vdpsp(output->matrix, 1, outputData.mutableBytes, 1, output.count);
+        if (input == self->_inputMatrix)
+        {
+            _singleInput  = inputData;
+            _singleOutput = outputData;
+        }
+    }
+    x = inputData.bytes;
+    y = outputData.bytes;
+    
+    // Buffers
+    int maxRows = input->rows;
+    int maxWeights = 0;
+    for (YCFullyConnectedLayer *layer in layers)
+    {
+        maxRows    = MAX(maxRows, layer.outputSize);
+        maxWeights = MAX(maxWeights, (int)layer.weightMatrix.count);
+    }
+    float **activations = malloc(L * sizeof(float *));
+    float **weights     = malloc(L * sizeof(float *));
+    for (int l=0; l<L; l++)
+    {
+        YCFullyConnectedLayer *layer = layers[l];
+        activations[l] = malloc(layer.outputSize * S * sizeof(float));
+        weights[l]     = malloc(layer.weightMatrix.count * sizeof(float));
+        vDSP_vdpsp(layer.weightMatrix->matrix, 1, weights[l], 1, layer.weightMatrix.count);
+    }
+    float *delta     = malloc(maxRows * S * sizeof(float));
+    float *nextDelta = malloc(maxRows * S * sizeof(float));
+    float *partial   = malloc(maxWeights * sizeof(float));
+    
+    // Forward pass
+    const float *incoming = x;
+    for (int l=0; l<L; l++)
+    {
+        YCFullyConnectedLayer *layer = layers[l];
+        int I = layer.inputSize;
+        int O = layer.outputSize;
+        double *bias = layer.biasVector->matrix;
+        for (int o=0; o<O; o++)
+        {
+            float b = bias[o];
+            vDSP_vfill(&b, activations[l] + o * S, 1, S);
+        }
+        cblas_sgemm(CblasRowMajor, CblasTrans, CblasNoTrans, O, S, I,
+                    1.0f, weights[l], O, incoming, S, 1.0f, activations[l], S);
+        [layer activationFunctionOnFloatValues:activations[l] count:O * S];
+        incoming = activations[l];
+    }
+    
+    // Output deltas: (a - y) .* f'(a)
+    YCFullyConnectedLayer *last = [layers lastObject];
+    int outputCount = last.outputSize * S;
+    vDSP_vsub(y, 1, activations[L-1], 1, delta, 1, outputCount);
+    [last activationFunctionGradientOnFloatValues:activations[L-1] count:outputCount];
+    vDSP_vmul(delta, 1, activations[L-1], 1, delta, 1, outputCount);
+    
+    // Backward pass, reducing gradients per batch into double precision
+    NSMutableArray *weightGradients = [NSMutableArray array];
+    NSMutableArray *biasGradients   = [NSMutableArray array];
+    for (YCFullyConnectedLayer *layer in layers)
     {
-        [m multiplyWithScalar:mult];
+        [weightGradients addObject:[Matrix matrixLike:layer.weightMatrix]];
+        [biasGradients addObject:[Matrix matrixLike:layer.biasVector]];
     }
-    for (Matrix *m in biasGradients)
+    
+    BOOL valid = YES;
+    float smallest = FLT_MIN / FLT_EPSILON;
+    for (int l=L-1; l>=0 && valid; l--)
     {
-        [m multiplyWithScalar:mult];
+        YCFullyConnectedLayer *layer = layers[l];
+        int I = layer.inputSize;
+        int O = layer.outputSize;
+        const float *in = l == 0 ? x : activations[l-1];
+        double *wg = ((Matrix *)weightGradients[l])->matrix;
+        double *bg = ((Matrix *)biasGradients[l])->matrix;
+        
+        // Underflow check: deltas whose largest magnitude has lost its precision
+        float largest;
+        vDSP_maxmgv(delta, 1, &largest, O * S);
+        if (!isfinite(largest) || (largest > 0 && largest < smallest))
+        {
+            valid = NO;
+            break;
+        }
+        
+        for (int b=0; b<batchCount; b++)
+        {
+            int c0 = b * B;
+            int n  = MIN(B, S - c0);
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasTrans, I, O, n,
+                        1.0f, in + c0, S, delta + c0, S, 0.0f, partial, O);
+            for (int i=0, count=I*O; i<count; i++) wg[i] += partial[i];
+            for (int o=0; o<O; o++)
+            {
+                float sum;
+                vDSP_sve(delta + o * S + c0, 1, &sum, n);
+                bg[o] += sum;
+            }
+        }
+        
+        if (l > 0)
+        {
+            // delta(l-1) = W(l) * delta(l) .* f'(a(l-1))
+            cblas_sgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, I, S, O,
+                        1.0f, weights[l], O, delta, S, 0.0f, nextDelta, S);
+            [layers[l-1] activationFunctionGradientOnFloatValues:activations[l-1] count:I * S];
+            vDSP_vmul(nextDelta, 1, activations[l-1], 1, nextDelta, 1, I * S);
+            float *t = delta; delta = nextDelta; nextDelta = t;
+        }
+    }
+    
+    for (int l=0; l<L; l++)
+    {
+        free(activations[l]);
+        free(weights[l]);
+    }
+    free(activations);
+    free(weights);
+    free(delta);
+    free(nextDelta);
+    free(partial);
+    
+    if (!valid) return NO;
+    
+    // Regularization & division with output size and sample count
+    [self scaleWeightGradients:weightGradients biasGradients:biasGradients
+                        layers:layers exampleCount:S];
+    for (int l=0; l<L; l++)
+    {
+        Matrix *wg = weightGradients[l];
+        Matrix *bg = biasGradients[l];
+        for (int i=0, count=(int)wg.count; i<count; i++)
+        {
+            if (!isfinite(wg->matrix[i])) return NO;
+        }
+        for (int i=0, count=(int)bg.count; i<count; i++)
+        {
+            if (!isfinite(bg->matrix[i])) return NO;
+        }
     }
     [self storeWeights:weightGradients biases:biasGradients toVector:derivatives];
+    return YES;
 }
 
 - (NSArray *)modelWeightsWithParameters:(Matrix *)parameters
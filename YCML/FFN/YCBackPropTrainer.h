@@ -21,6 +21,7 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 #import "YCSupervisedTrainer.h"
+@class YCFFN, YCSparseMatrix;
 
 @interface YCBackPropTrainer : YCSupervisedTrainer
 
@@ -28,4 +29,19 @@
 
 + (Class)optimizerClass;
 
+/**
+ Trains a model using a sparse input matrix, e.g. one obtained through
+ YCDataframe -getSparseMatrixUsingConversionArray:. Inputs are scaled
+ without centering, so that they remain sparse, and the first layer is
+ propagated and differentiated over the non-zero input elements only.
+ The resulting model may be activated with dense or sparse inputs.
+ 
+ @param model  The model to train, or nil to create a new one.
+ @param input  The sparse input matrix (NxS).
+ @param output The output matrix (OxS).
+ 
+ @return The trained model.
+ */
+- (YCFFN *)train:(YCFFN *)model sparseInputMatrix:(YCSparseMatrix *)input outputMatrix:(Matrix *)output;
+
 @end
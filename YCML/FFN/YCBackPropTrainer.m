@@ -28,6 +28,8 @@
 #import "YCFullyConnectedLayer.h"
 #import "YCSigmoidLayer.h"
 #import "YCLinearLayer.h"
+#import "YCSparseMatrix.h"
+#import "Matrix+Transform.h"
 
 // N: Size of input
 // S: Number of samples
@@ -70,6 +72,9 @@
         self.settings[@"Target"]             = @-1;
         self.settings[@"Samples"]            = @-1;
         self.settings[@"Batch Size"]         = @500;
+        self.settings[@"Single Precision"]   = @NO;
+        self.settings[@"Warm Start"]         = @NO;
+        self.settings[@"Keep Pruned Weights"] = @NO;
     }
     return self;
 }
@@ -85,15 +90,91 @@
     Matrix *inputTransform  = [input rowWiseMapToDomain:domain basis:StDev];
     Matrix *outputTransform = [output rowWiseMapToDomain:domain basis:MinMax];
     Matrix *invOutTransform = [output rowWiseInverseMapFromDomain:domain basis:MinMax];
+    if ([self shouldWarmStartModel:model])
+    {
+        inputTransform  = model.inputTransform;
+        invOutTransform = model.outputTransform;
+        outputTransform = [invOutTransform matrixByInvertingRowWiseTransform];
+    }
     Matrix *scaledInput     = [input matrixByRowWiseMapUsing:inputTransform];
     Matrix *scaledOutput    = [output matrixByRowWiseMapUsing:outputTransform];
     
     // Step II. Populating network with properly sized layers if required
+    [self prepareModel:model inputSize:scaledInput.rows outputSize:scaledOutput.rows];
+    
+    // Step III. Defining the Backprop problem
+    YCBackPropProblem *p       = [[[[self class] problemClass] alloc] initWithInputMatrix:scaledInput
+                                                                             outputMatrix:scaledOutput
+                                                                                    model:model];
+    
+    // Steps IV-VI. Optimizing and copying results to the model
+    [self optimizeProblem:p model:model inputTransform:inputTransform outputTransform:invOutTransform];
+}
+
+- (YCFFN *)train:(YCFFN *)model sparseInputMatrix:(YCSparseMatrix *)input outputMatrix:(Matrix *)output
+{
+    self.shouldStop = NO;
+    YCFFN *theModel = model;
+    if (!theModel)
+    {
+        theModel = [[[[self class] modelClass] alloc] init];
+    }
+    [self performTrainingModel:theModel sparseInputMatrix:input outputMatrix:output];
+    return self.shouldStop ? nil : theModel;
+}
+
+- (void)performTrainingModel:(YCFFN *)model
+           sparseInputMatrix:(YCSparseMatrix *)input
+                outputMatrix:(Matrix *)output
+{
+    // Step I. Scaling inputs without centering, so that they remain sparse
+    YCDomain domain = YCMakeDomain(0, 1);
+    Matrix *inputTransform       = [input rowWiseScalingTransform];
+    Matrix *outputTransform      = [output rowWiseMapToDomain:domain basis:MinMax];
+    Matrix *invOutTransform      = [output rowWiseInverseMapFromDomain:domain basis:MinMax];
+    if ([self shouldWarmStartModel:model])
+    {
+        // Only scaling input transforms keep the input sparse, so the offsets
+        // of the previous input transform are folded into the first layer:
+        // x' = a.*x + b => z = W'(a.*x) + (B + W'b)
+        Matrix *offsets = [model.inputTransform column:1];
+        if (offsets.min != 0 || offsets.max != 0)
+        {
+            NSMutableArray *layers = [model.layers mutableCopy];
+            YCFullyConnectedLayer *first = [layers[0] copy];
+            first.biasVector = [first.biasVector matrixByAdding:
+                                [first.weightMatrix matrixByTransposingAndMultiplyingWithRight:offsets]];
+            layers[0] = first;
+            model.layers = layers;
+            
+            Matrix *scaling = [model.inputTransform copy];
+            for (int i=0; i<scaling->rows; i++) scaling->matrix[2*i + 1] = 0;
+            model.inputTransform = scaling;
+        }
+        inputTransform  = model.inputTransform;
+        invOutTransform = model.outputTransform;
+        outputTransform = [invOutTransform matrixByInvertingRowWiseTransform];
+    }
+    YCSparseMatrix *scaledInput  = [input sparseMatrixByRowWiseScaling:inputTransform];
+    Matrix *scaledOutput         = [output matrixByRowWiseMapUsing:outputTransform];
+    
+    // Step II. Populating network with properly sized layers if required
+    [self prepareModel:model inputSize:scaledInput.rows outputSize:scaledOutput.rows];
+    
+    // Step III. Defining the Backprop problem
+    YCBackPropProblem *p = [[[[self class] problemClass] alloc] initWithSparseInputMatrix:scaledInput
+                                                                             outputMatrix:scaledOutput
+                                                                                    model:model];
+    
+    // Steps IV-VI. Optimizing and copying results to the model
+    [self optimizeProblem:p model:model inputTransform:inputTransform outputTransform:invOutTransform];
+}
+
+- (void)prepareModel:(YCFFN *)model inputSize:(int)inputSize outputSize:(int)outputSize
+{
     int hiddenCount      = [self.settings[@"Hidden Layer Count"] intValue];
     int hiddenSize       = [self.settings[@"Hidden Layer Size"] intValue];
-    int inputSize             = scaledInput.rows;
-    int outputSize            = scaledOutput.rows;
-
+    
     if (!model || model.layers.count == 0)
     {
         [self initialize:model
@@ -104,13 +185,37 @@
                       L1:[self.settings[@"L1"] doubleValue]
                       L2:[self.settings[@"L2"] doubleValue]];
     }
-    
-    // Step III. Defining the Backprop problem and GD properties
-    YCBackPropProblem *p       = [[[[self class] problemClass] alloc] initWithInputMatrix:scaledInput
-                                                                             outputMatrix:scaledOutput
-                                                                                    model:model];
+}
+
+- (void)optimizeProblem:(YCBackPropProblem *)p
+                  model:(YCFFN *)model
+         inputTransform:(Matrix *)inputTransform
+        outputTransform:(Matrix *)invOutTransform
+{
+    // Step III. Setting problem and optimizer properties
     p.sampleCount              = [self.settings[@"Samples"] intValue];
     p.batchSize                = [self.settings[@"Batch Size"] intValue];
+    p.singlePrecision          = [self.settings[@"Single Precision"] boolValue];
+    if ([self shouldWarmStartModel:model])
+    {
+        NSArray *layers = model.layers;
+        Matrix *parameters = [Matrix matrixOfRows:[p parameterCount] columns:1];
+        [p storeWeights:[layers valueForKey:@"weightMatrix"]
+                 biases:[layers valueForKey:@"biasVector"]
+               toVector:parameters];
+        p.initialParameters = parameters;
+        
+        if ([self.settings[@"Keep Pruned Weights"] boolValue])
+        {
+            // Zero weights stay at zero; biases are always free
+            Matrix *mask = [Matrix matrixOfRows:[p parameterCount] columns:1 value:1];
+            for (int i=0, n=[p weightParameterCount]; i<n; i++)
+            {
+                if (parameters->matrix[i] == 0) mask->matrix[i] = 0;
+            }
+            p.parameterMask = mask;
+        }
+    }
     _currentOptimizer          = [[[[self class] optimizerClass] alloc] initWithProblem:p];
     _currentOptimizer.delegate = self;
     [_currentOptimizer.settings addEntriesFromDictionary:self.settings];
@@ -124,6 +229,10 @@
     
     // Step V. Copying statistics, weight and bias matrices.
     model.statistics[@"Iterations"] = _currentOptimizer.state[@"currentIteration"];
+    if (p.singlePrecision)
+    {
+        model.statistics[@"Double Precision Fallbacks"] = @(p.doublePrecisionFallbacks);
+    }
     
     NSArray *weights          = [p modelWeightsWithParameters:_currentOptimizer.state[@"values"]];
     NSArray *biases           = [p modelBiasesWithParameters:_currentOptimizer.state[@"values"]];
@@ -142,6 +251,13 @@
     model.outputTransform     = invOutTransform;
 }
 
+// Warm starting requires a trained model, whose transforms are reused
+- (BOOL)shouldWarmStartModel:(YCFFN *)model
+{
+    return [self.settings[@"Warm Start"] boolValue] && model.layers.count > 0 &&
+    model.inputTransform && model.outputTransform;
+}
+
 - (void)initialize:(YCFFN *)model
      withInputSize:(int)inputSize
         hiddenSize:(int)hiddenSize
@@ -0,0 +1,75 @@
+//
+//  YCFFN+Pruning.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCFFN.h"
+@class YCBackPropTrainer;
+
+/**
+ Post-training magnitude pruning. Weights are pruned in square blocks,
+ scored by their root mean square magnitude, so that pruned layers can be
+ stored in block-sparse form and propagated through a sparse kernel (see
+ YCFullyConnectedLayer -compressWeightsWithBlockSize:maximumDensity:).
+ A block size of 1 prunes individual weights; such layers are compressed
+ in blocks of 8, and only if enough of those blocks are empty.
+ Pruning replaces the receiver's layers with pruned copies, and sets the
+ "Weight Density" statistic to the fraction of non-zero weights.
+ */
+@interface YCFFN (Pruning)
+
+/**
+ Sets to zero the weight blocks whose magnitude is less than |threshold|.
+ 
+ @param threshold The magnitude threshold.
+ @param blockSize The size of the square weight blocks.
+ */
+- (void)pruneWeightsBelowThreshold:(double)threshold blockSize:(int)blockSize;
+
+/**
+ Keeps the largest weight blocks of each layer, up to |fraction| of the
+ blocks of the layer, and sets the rest to zero.
+ 
+ @param fraction  The fraction of blocks to keep per layer.
+ @param blockSize The size of the square weight blocks.
+ */
+- (void)pruneWeightsKeepingFraction:(double)fraction blockSize:(int)blockSize;
+
+/**
+ Retunes the remaining weights of a pruned receiver, by training it with
+ |trainer| starting from its current weights and keeping pruned weights
+ at zero. The trainer settings are restored afterwards.
+ 
+ @param trainer The trainer.
+ @param input   The training input (NxS).
+ @param output  The training output (OxS).
+ 
+ @return The receiver, or nil if training was stopped.
+ */
+- (YCFFN *)retuneWithTrainer:(YCBackPropTrainer *)trainer
+                 inputMatrix:(Matrix *)input
+                outputMatrix:(Matrix *)output;
+
+/**
+ Returns the fraction of non-zero weights across the receiver's layers.
+ */
+@property (readonly) double weightDensity;
+
+@end
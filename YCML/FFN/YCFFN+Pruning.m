@@ -0,0 +1,162 @@
+//
+//  YCFFN+Pruning.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCFFN+Pruning.h"
+#import "YCBackPropTrainer.h"
+#import "YCFullyConnectedLayer.h"
+#import "YCFullyConnectedLayer+IO.h"
+#import "YCBlockSparseMatrix.h"
+
+// Above this fraction of non-zero blocks, the dense kernel is faster
+#define MAXIMUM_SPARSE_DENSITY 0.5
+
+// Block size used for compressing element-wise pruned layers
+#define DEFAULT_COMPRESSION_BLOCK_SIZE 8
+
+@implementation YCFFN (Pruning)
+
+- (void)pruneWeightsBelowThreshold:(double)threshold blockSize:(int)blockSize
+{
+    [self pruneWeightsWithBlockSize:blockSize selector:^double(Matrix *magnitudes) {
+        return threshold;
+    }];
+}
+
+- (void)pruneWeightsKeepingFraction:(double)fraction blockSize:(int)blockSize
+{
+    [self pruneWeightsWithBlockSize:blockSize selector:^double(Matrix *magnitudes) {
+        int count = (int)magnitudes.count;
+        int keep = (int)round(MAX(0.0, MIN(1.0, fraction)) * count);
+        if (keep >= count) return 0;
+        if (keep == 0) return INFINITY;
+        Matrix *sorted = [magnitudes copy];
+        vDSP_vsortD(sorted->matrix, count, -1);
+        return sorted->matrix[keep - 1];
+    }];
+}
+
+// Prunes the weight blocks of each layer whose magnitude is less than the
+// threshold returned by |selector| for the block magnitudes of the layer
+- (void)pruneWeightsWithBlockSize:(int)blockSize selector:(double (^)(Matrix *magnitudes))selector
+{
+    int bs = MAX(1, blockSize);
+    NSMutableArray *layers = [NSMutableArray array];
+    for (YCFullyConnectedLayer *original in self.layers)
+    {
+        YCFullyConnectedLayer *layer = [original copy];
+        Matrix *weights = [layer.weightMatrix copy];
+        int I = weights->rows;
+        int O = weights->columns;
+        int blockRows = (I + bs - 1) / bs;
+        int blockColumns = (O + bs - 1) / bs;
+        
+        Matrix *magnitudes = [Matrix matrixOfRows:blockRows columns:blockColumns];
+        for (int bi=0; bi<blockRows; bi++)
+        {
+            for (int bo=0; bo<blockColumns; bo++)
+            {
+                int tr = MIN(bs, I - bi * bs);
+                int tc = MIN(bs, O - bo * bs);
+                double sum = 0;
+                for (int r=0; r<tr; r++)
+                {
+                    const double *row = weights->matrix + (bi * bs + r) * O + bo * bs;
+                    for (int c=0; c<tc; c++) sum += row[c] * row[c];
+                }
+                magnitudes->matrix[bi * blockColumns + bo] = sqrt(sum / (tr * tc));
+            }
+        }
+        
+        double threshold = selector(magnitudes);
+        for (int bi=0; bi<blockRows; bi++)
+        {
+            for (int bo=0; bo<blockColumns; bo++)
+            {
+                if (magnitudes->matrix[bi * blockColumns + bo] >= threshold) continue;
+                int tr = MIN(bs, I - bi * bs);
+                int tc = MIN(bs, O - bo * bs);
+                for (int r=0; r<tr; r++)
+                {
+                    memset(weights->matrix + (bi * bs + r) * O + bo * bs, 0, tc * sizeof(double));
+                }
+            }
+        }
+        
+        layer.weightMatrix = weights;
+        [layer compressWeightsWithBlockSize:bs > 1 ? bs : DEFAULT_COMPRESSION_BLOCK_SIZE
+                             maximumDensity:MAXIMUM_SPARSE_DENSITY];
+        [layers addObject:layer];
+    }
+    self.layers = layers;
+    self.statistics[@"Weight Density"] = @(self.weightDensity);
+}
+
+- (YCFFN *)retuneWithTrainer:(YCBackPropTrainer *)trainer
+                 inputMatrix:(Matrix *)input
+                outputMatrix:(Matrix *)output
+{
+    // Training replaces the weight matrices, so the block sizes of
+    // compressed layers are recorded beforehand
+    NSMutableArray *blockSizes = [NSMutableArray array];
+    for (YCFullyConnectedLayer *layer in self.layers)
+    {
+        [blockSizes addObject:@(layer.sparseWeightMatrix.blockSize)];
+    }
+    
+    NSDictionary *settings = [trainer.settings copy];
+    trainer.settings[@"Warm Start"] = @YES;
+    trainer.settings[@"Keep Pruned Weights"] = @YES;
+    YCFFN *result = (YCFFN *)[trainer train:self inputMatrix:input outputMatrix:output];
+    [trainer.settings setDictionary:settings];
+    if (!result) return nil;
+    
+    [self.layers enumerateObjectsUsingBlock:^(YCFullyConnectedLayer *layer, NSUInteger idx, BOOL *stop) {
+        int blockSize = [blockSizes[idx] intValue];
+        if (blockSize > 0)
+        {
+            [layer compressWeightsWithBlockSize:blockSize maximumDensity:1.0];
+        }
+    }];
+    self.statistics[@"Weight Density"] = @(self.weightDensity);
+    return self;
+}
+
+- (double)weightDensity
+{
+    double nonZero = 0;
+    double total = 0;
+    for (YCFullyConnectedLayer *layer in self.layers)
+    {
+        Matrix *weights = layer.weightMatrix;
+        NSUInteger count = weights.count;
+        for (NSUInteger i=0; i<count; i++)
+        {
+            if (weights->matrix[i] != 0) nonZero++;
+        }
+        total += count;
+    }
+    return total > 0 ? nonZero / total : 0;
+}
+
+@end
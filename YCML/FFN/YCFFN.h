@@ -21,7 +21,16 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 #import "YCSupervisedModel.h"
+@class YCFFNPlan, YCSparseMatrix;
 
+/**
+ Feed-forward network model. Activation through activateWithMatrix: runs in
+ inference mode: samples are propagated in fixed-size column chunks through
+ two ping-pong buffers sized to the widest layer, and no per-layer history
+ is retained. Buffers are drawn from a pool private to the receiver, one
+ pair per concurrent call. Training code that requires layer activations
+ should call forward: on the individual layers instead.
+ */
 @interface YCFFN : YCSupervisedModel
 
 /**
@@ -44,4 +53,24 @@
  */
 @property (readonly) int hiddenLayerCount;
 
+/**
+ Activates the receiver with a sparse input matrix. The input transform
+ is folded on the fly: its scale is applied to the non-zero elements and
+ its offset to the first layer's bias, so the input is never densified.
+ 
+ @param input The sparse input matrix (NxS).
+ 
+ @return The output matrix (OxS).
+ */
+- (Matrix *)activateWithSparseMatrix:(YCSparseMatrix *)input;
+
+/**
+ Compiles the receiver into an immutable execution plan for low-latency
+ inference. The plan is a snapshot; it should be recompiled if the
+ receiver is trained further.
+ 
+ @return The compiled plan.
+ */
+- (YCFFNPlan *)compiledPlan;
+
 @end
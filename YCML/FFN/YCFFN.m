@@ -41,37 +41,248 @@
 
 #import "YCFFN.h"
 #import "YCFullyConnectedLayer.h"
+#import "YCLinearLayer.h"
+#import "YCFFNPlan.h"
+#import "YCSparseMatrix.h"
+#import "YCBlockSparseMatrix.h"
 @import YCMatrix;
+@import Accelerate;
+
+// Number of samples (columns) propagated through the network at a time
+#define CHUNK_SIZE 256
 
 @implementation YCFFN
+{
+    NSMutableArray *_scratchPool;
+}
 
 - (Matrix *)activateWithMatrix:(Matrix *)matrix
 {
     NSAssert([self.layers count], @"Model not trained");
     NSAssert([matrix rows] == self.inputSize, @"Input size mismatch");
     
-    // 1. Scale input
-    Matrix *scaledInput = matrix; // NxS
+    // Work on a consistent snapshot of the receiver's state
+    NSArray *layers = self.layers;
+    Matrix *inputTransform = self.inputTransform;
+    Matrix *outputTransform = self.outputTransform;
+    
+    int N = matrix->rows;
+    int S = matrix->columns;
+    int O = [[layers lastObject] outputSize];
+    int layerCount = (int)[layers count];
+    Matrix *output = [Matrix matrixOfRows:O columns:S];
+    
+    // 1. Check out ping-pong buffers, sized to the widest layer
+    int width = inputTransform ? N : 0;
+    for (YCFullyConnectedLayer *layer in layers)
+    {
+        width = MAX(width, layer.outputSize);
+    }
+    int bufferSize = width * CHUNK_SIZE;
+    NSMutableData *scratch = [self checkOutScratchOfLength:2 * bufferSize * sizeof(double)];
+    double *buffers[2] = {scratch.mutableBytes, (double *)scratch.mutableBytes + bufferSize};
+    
+    for (int c0=0; c0<S; c0+=CHUNK_SIZE)
+    {
+        int c = MIN(CHUNK_SIZE, S - c0);
+        int current = 0;
+        
+        // 2. Scale input chunk, or read it in place
+        const double *input = matrix->matrix + c0;
+        int inputStride = S;
+        if (inputTransform)
+        {
+            double *scaled = buffers[current];
+            double *transform = inputTransform->matrix;
+            for (int i=0; i<N; i++)
+            {
+                vDSP_vsmsaD(input + i * S, 1, &transform[2*i], &transform[2*i + 1],
+                            scaled + i * c, 1, c);
+            }
+            input = scaled;
+            inputStride = c;
+            current = 1;
+        }
+        
+        // 3. Calculate layer-by-layer, alternating between buffers
+        for (int i=0; i<layerCount; i++)
+        {
+            YCFullyConnectedLayer *layer = layers[i];
+            if (i == layerCount - 1)
+            {
+                [layer forwardValues:input stride:inputStride
+                                into:output->matrix + c0 stride:S
+                             columns:c];
+            }
+            else
+            {
+                double *next = buffers[current];
+                [layer forwardValues:input stride:inputStride
+                                into:next stride:c
+                             columns:c];
+                input = next;
+                inputStride = c;
+                current = 1 - current;
+            }
+        }
+        
+        // 4. Scale output chunk
+        if (outputTransform)
+        {
+            double *transform = outputTransform->matrix;
+            for (int i=0; i<O; i++)
+            {
+                double *row = output->matrix + i * S + c0;
+                vDSP_vsmsaD(row, 1, &transform[2*i], &transform[2*i + 1], row, 1, c);
+            }
+        }
+    }
+    
+    [self checkInScratch:scratch];
+    return output;
+}
+
+- (void)foldTransforms
+{
+    if (!self.layers.count) return;
+    
+    // Layers are replaced by copies, as they may be shared with other models.
+    // Weights are scaled into new matrices, and compressed layers are
+    // compressed again, so that the block-sparse form stays in sync
+    NSMutableArray *layers = [self.layers mutableCopy];
+    
+    // Input: x' = a.*x + b => z = W'x' + B = (diag(a)W)'x + (B + W'b)
     if (self.inputTransform)
     {
-        scaledInput = [matrix matrixByRowWiseMapUsing:self.inputTransform];
+        YCFullyConnectedLayer *first = [layers[0] copy];
+        Matrix *weights = [first.weightMatrix copy];
+        Matrix *offset = [self.inputTransform column:1];
+        [first.biasVector add:[weights matrixByTransposingAndMultiplyingWithRight:offset]];
+        double *transform = self.inputTransform->matrix;
+        for (int i=0; i<weights->rows; i++)
+        {
+            double *row = weights->matrix + i * weights->columns;
+            vDSP_vsmulD(row, 1, &transform[2*i], row, 1, weights->columns);
+        }
+        [self replaceWeightsOfLayer:first with:weights];
+        layers[0] = first;
+        self.inputTransform = nil;
     }
     
-    // 2. Calculate layer-by-layer
+    // Output: y' = c.*y + d, only if the output layer is linear
+    // => y' = (W diag(c))'x + (c.*B + d)
+    if (self.outputTransform && [[layers lastObject] isMemberOfClass:[YCLinearLayer class]])
+    {
+        YCFullyConnectedLayer *last = [[layers lastObject] copy];
+        Matrix *weights = [last.weightMatrix copy];
+        Matrix *scale = [self.outputTransform column:0];
+        Matrix *offset = [self.outputTransform column:1];
+        for (int i=0; i<weights->rows; i++)
+        {
+            double *row = weights->matrix + i * weights->columns;
+            vDSP_vmulD(row, 1, scale->matrix, 1, row, 1, weights->columns);
+        }
+        [self replaceWeightsOfLayer:last with:weights];
+        [last.biasVector elementWiseMultiply:scale];
+        [last.biasVector add:offset];
+        layers[layers.count - 1] = last;
+        self.outputTransform = nil;
+    }
     
-    Matrix *output = scaledInput;
+    self.layers = layers;
+}
+
+// Assigns |weights| to |layer|, compressing them again with the same
+// block size if the layer was compressed
+- (void)replaceWeightsOfLayer:(YCFullyConnectedLayer *)layer with:(Matrix *)weights
+{
+    int blockSize = layer.sparseWeightMatrix.blockSize;
+    layer.weightMatrix = weights;
+    if (blockSize > 0)
+    {
+        [layer compressWeightsWithBlockSize:blockSize maximumDensity:1.0];
+    }
+}
+
+- (Matrix *)activateWithSparseMatrix:(YCSparseMatrix *)input
+{
+    NSAssert(input.rows == self.inputSize, @"Input size mismatch");
+    
+    // Work on a consistent snapshot of the receiver's state
+    NSArray *layers = self.layers;
+    Matrix *inputTransform = self.inputTransform;
+    Matrix *outputTransform = self.outputTransform;
+    YCFullyConnectedLayer *first = layers[0];
+    int S = input.columns;
     
-    for (int i=0, j=(int)[self.layers count]; i<j; i++)
+    // Input: x' = a.*x + b => z = W'(a.*x) + (B + W'b), where a.*x is sparse
+    YCSparseMatrix *scaledInput = input;
+    Matrix *bias = first.biasVector;
+    if (inputTransform)
     {
-        output = [self.layers[i] forward:output];
+        scaledInput = [input sparseMatrixByRowWiseScaling:inputTransform];
+        Matrix *offset = [inputTransform column:1];
+        if (offset.min != 0 || offset.max != 0)
+        {
+            bias = [bias matrixByAdding:[first.weightMatrix matrixByTransposingAndMultiplyingWithRight:offset]];
+        }
     }
     
-    // 5. Scale output and return
-    if (self.outputTransform)
+    Matrix *activation = [Matrix matrixOfRows:first.outputSize columns:S];
+    [first forwardSparse:scaledInput bias:bias into:activation];
+    for (int l=1, count=(int)layers.count; l<count; l++)
     {
-        return [output matrixByRowWiseMapUsing:self.outputTransform];
+        YCFullyConnectedLayer *layer = layers[l];
+        Matrix *next = [Matrix matrixOfRows:layer.outputSize columns:S];
+        [layer forward:activation into:next];
+        activation = next;
+    }
+    
+    if (outputTransform)
+    {
+        double *transform = outputTransform->matrix;
+        for (int i=0; i<activation->rows; i++)
+        {
+            double *row = activation->matrix + i * S;
+            vDSP_vsmsaD(row, 1, &transform[2*i], &transform[2*i + 1], row, 1, S);
+        }
+    }
+    return activation;
+}
+
+- (YCFFNPlan *)compiledPlan
+{
+    return [YCFFNPlan planWithModel:self];
+}
+
+#pragma mark - Scratch Space
+
+// Buffers are handed out to one caller at a time, so that concurrent
+// activations of the same model never share intermediate results.
+// Once returned, they are reused by subsequent calls.
+
+- (NSMutableData *)checkOutScratchOfLength:(NSUInteger)length
+{
+    NSMutableData *scratch;
+    @synchronized(self)
+    {
+        scratch = [_scratchPool lastObject];
+        if (scratch) [_scratchPool removeLastObject];
+    }
+    if (scratch.length < length)
+    {
+        scratch = [NSMutableData dataWithLength:length];
+    }
+    return scratch;
+}
+
+- (void)checkInScratch:(NSMutableData *)scratch
+{
+    @synchronized(self)
+    {
+        if (!_scratchPool) _scratchPool = [NSMutableArray array];
+        [_scratchPool addObject:scratch];
     }
-    return output;
 }
 
 - (int)inputSize
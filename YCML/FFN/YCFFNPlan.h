@@ -0,0 +1,85 @@
+//
+//  YCFFNPlan.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+@class YCFFN, Matrix;
+
+/**
+ A compiled, immutable execution plan for a trained YCFFN, intended for
+ low-latency inference of single samples and small batches. Compiling
+ folds the model's transforms (see YCFFN -foldTransforms) in a copy of
+ the model, copies all weights and biases into one contiguous blob,
+ precomputes buffer offsets and resolves each layer's activation to a
+ built-in kernel, so that activation involves no Objective-C messaging
+ and, for single samples and small batches, no allocation. Layers of
+ classes other than the built-in ones are supported through their
+ activationFunctionOnValues:count: method.
+ 
+ The plan does not reference the model's weights, so later changes to
+ the model are not reflected. Plans are safe to use from multiple threads.
+ */
+@interface YCFFNPlan : NSObject
+
+/**
+ Compiles a plan for the passed model.
+ 
+ @param model The trained model.
+ 
+ @return The compiled plan.
+ */
++ (instancetype)planWithModel:(YCFFN *)model;
+
+- (instancetype)initWithModel:(YCFFN *)model;
+
+/**
+ Activates the plan with a single sample.
+ 
+ @param input  Pointer to the input values (inputSize).
+ @param output Pointer to the output values (outputSize).
+ */
+- (void)activateSample:(const double *)input output:(double *)output;
+
+/**
+ Activates the plan with a row-major batch of samples, one per column.
+ 
+ @param input   Pointer to the input values (inputSize x columns).
+ @param output  Pointer to the output values (outputSize x columns).
+ @param columns The number of samples.
+ */
+- (void)activateValues:(const double *)input output:(double *)output columns:(int)columns;
+
+/**
+ Activates the plan with a matrix of samples, one per column.
+ 
+ @param input The input matrix (inputSize x S).
+ 
+ @return The output matrix (outputSize x S).
+ */
+- (Matrix *)activateWithMatrix:(Matrix *)input;
+
+@property (readonly) int inputSize;
+
+@property (readonly) int outputSize;
+
+@property (readonly) int layerCount;
+
+@end
@@ -0,0 +1,262 @@
+//
+//  YCFFNPlan.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCFFNPlan.h"
+#import "YCFFN.h"
+#import "YCFullyConnectedLayer.h"
+#import "YCLinearLayer.h"
+#import "YCSigmoidLayer.h"
+#import "YCTanhLayer.h"
+#import "YCReLULayer.h"
+#import "YCActivationKernels.h"
+
+// Widest layer for which single sample buffers are kept on the stack
+#define STACK_WIDTH 512
+
+// Largest number of scratch values for batches, that are kept on the stack
+#define STACK_ELEMENTS 4096
+
+typedef enum YCPlanActivation
+{
+    YCPlanLinear,
+    YCPlanSigmoid,
+    YCPlanTanh,
+    YCPlanReLU,
+    YCPlanGeneric
+} YCPlanActivation;
+
+typedef struct YCPlanLayer
+{
+    int inputSize;
+    int outputSize;
+    size_t weightOffset;  // I x O, row-major
+    size_t biasOffset;    // O
+    YCPlanActivation activation;
+} YCPlanLayer;
+
+@implementation YCFFNPlan
+{
+    double *_blob;
+    YCPlanLayer *_layers;
+    NSArray *_genericLayers;   // Layer objects, used only for YCPlanGeneric
+    size_t _outputScaleOffset; // Output transform, if any (O each)
+    size_t _outputOffsetOffset;
+    BOOL _hasOutputTransform;
+    int _maxWidth;
+}
+
++ (instancetype)planWithModel:(YCFFN *)model
+{
+    return [[self alloc] initWithModel:model];
+}
+
+- (instancetype)initWithModel:(YCFFN *)model
+{
+    self = [super init];
+    if (self)
+    {
+        // Transforms are folded into a copy of the model, so the input
+        // transform is always gone, and the output one remains only if the
+        // output layer is not linear
+        YCFFN *folded = [model copy];
+        [folded foldTransforms];
+        NSArray *layers      = folded.layers;
+        Matrix *outTransform = folded.outputTransform;
+        NSAssert(layers.count > 0, @"Cannot compile a model without layers");
+        
+        _layerCount = (int)layers.count;
+        _layers     = calloc(_layerCount, sizeof(YCPlanLayer));
+        
+        // Offsets
+        size_t size = 0;
+        _maxWidth = 0;
+        for (int l=0; l<_layerCount; l++)
+        {
+            YCFullyConnectedLayer *layer = layers[l];
+            YCPlanLayer *pl  = &_layers[l];
+            pl->inputSize    = layer.inputSize;
+            pl->outputSize   = layer.outputSize;
+            pl->weightOffset = size;
+            size            += pl->inputSize * pl->outputSize;
+            pl->biasOffset   = size;
+            size            += pl->outputSize;
+            pl->activation   = [self activationForLayer:layer];
+            _maxWidth = MAX(_maxWidth, MAX(pl->inputSize, pl->outputSize));
+        }
+        _inputSize  = _layers[0].inputSize;
+        _outputSize = _layers[_layerCount - 1].outputSize;
+        _hasOutputTransform = outTransform != nil;
+        if (_hasOutputTransform)
+        {
+            _outputScaleOffset  = size;
+            _outputOffsetOffset = size + _outputSize;
+            size += 2 * _outputSize;
+        }
+        
+        // Blob
+        _blob = malloc(size * sizeof(double));
+        for (int l=0; l<_layerCount; l++)
+        {
+            YCFullyConnectedLayer *layer = layers[l];
+            YCPlanLayer *pl = &_layers[l];
+            cblas_dcopy(pl->inputSize * pl->outputSize, layer.weightMatrix->matrix, 1,
+                        _blob + pl->weightOffset, 1);
+            cblas_dcopy(pl->outputSize, layer.biasVector->matrix, 1, _blob + pl->biasOffset, 1);
+        }
+        
+        // Output: y' = c.*y + d
+        if (_hasOutputTransform)
+        {
+            for (int o=0; o<_outputSize; o++)
+            {
+                _blob[_outputScaleOffset + o]  = [outTransform i:o j:0];
+                _blob[_outputOffsetOffset + o] = [outTransform i:o j:1];
+            }
+        }
+        
+        _genericLayers = layers;
+    }
+    return self;
+}
+
+- (YCPlanActivation)activationForLayer:(YCFullyConnectedLayer *)layer
+{
+    // Exact class matches only, as subclasses may redefine the activation
+    if ([layer isMemberOfClass:[YCLinearLayer class]]) return YCPlanLinear;
+    if ([layer isMemberOfClass:[YCSigmoidLayer class]]) return YCPlanSigmoid;
+    if ([layer isMemberOfClass:[YCTanhLayer class]]) return YCPlanTanh;
+    if ([layer isMemberOfClass:[YCReLULayer class]]) return YCPlanReLU;
+    return YCPlanGeneric;
+}
+
+- (void)dealloc
+{
+    free(_blob);
+    free(_layers);
+}
+
+#pragma mark - Kernels
+
+static inline void YCPlanActivate(YCPlanActivation activation, double *values, int count,
+                                  YCFullyConnectedLayer *genericLayer)
+{
+    switch (activation)
+    {
+        case YCPlanLinear:
+            break;
+        case YCPlanSigmoid:
+            YCSigmoidActivation(values, count);
+            break;
+        case YCPlanTanh:
+            YCTanhActivation(values, count);
+            break;
+        case YCPlanReLU:
+            YCReLUActivation(values, count);
+            break;
+        case YCPlanGeneric:
+            [genericLayer activationFunctionOnValues:values count:count];
+            break;
+    }
+}
+
+- (void)activateSample:(const double *)input output:(double *)output
+{
+    if (_maxWidth > STACK_WIDTH)
+    {
+        [self activateValues:input output:output columns:1];
+        return;
+    }
+    
+    double buffers[2][STACK_WIDTH];
+    const double *in = input;
+    for (int l=0; l<_layerCount; l++)
+    {
+        const YCPlanLayer *pl = &_layers[l];
+        double *out = l == _layerCount - 1 ? output : buffers[l % 2];
+        cblas_dcopy(pl->outputSize, _blob + pl->biasOffset, 1, out, 1);
+        cblas_dgemv(CblasRowMajor, CblasTrans, pl->inputSize, pl->outputSize,
+                    1.0, _blob + pl->weightOffset, pl->outputSize, in, 1, 1.0, out, 1);
+        YCPlanActivate(pl->activation, out, pl->outputSize,
+                       pl->activation == YCPlanGeneric ? _genericLayers[l] : nil);
+        in = out;
+    }
+    if (_hasOutputTransform)
+    {
+        vDSP_vmaD(output, 1, _blob + _outputScaleOffset, 1, _blob + _outputOffsetOffset, 1,
+                  output, 1, _outputSize);
+    }
+}
+
+- (void)activateValues:(const double *)input output:(double *)output columns:(int)columns
+{
+    if (columns == 1 && _maxWidth <= STACK_WIDTH)
+    {
+        [self activateSample:input output:output];
+        return;
+    }
+    
+    // Small batches are buffered on the stack, so that they don't allocate
+    int S = columns;
+    int scratchCount = 2 * _maxWidth * S;
+    double stackScratch[scratchCount <= STACK_ELEMENTS ? scratchCount : 1];
+    double *scratch = scratchCount <= STACK_ELEMENTS ? stackScratch :
+    malloc(scratchCount * sizeof(double));
+    const double *in = input;
+    for (int l=0; l<_layerCount; l++)
+    {
+        const YCPlanLayer *pl = &_layers[l];
+        int O = pl->outputSize;
+        double *out = l == _layerCount - 1 ? output : scratch + (l % 2) * _maxWidth * S;
+        for (int o=0; o<O; o++)
+        {
+            vDSP_vfillD(_blob + pl->biasOffset + o, out + o * S, 1, S);
+        }
+        cblas_dgemm(CblasRowMajor, CblasTrans, CblasNoTrans, O, S, pl->inputSize,
+                    1.0, _blob + pl->weightOffset, O, in, S, 1.0, out, S);
+        YCPlanActivate(pl->activation, out, O * S,
+                       pl->activation == YCPlanGeneric ? _genericLayers[l] : nil);
+        in = out;
+    }
+    if (scratch != stackScratch) free(scratch);
+    
+    if (_hasOutputTransform)
+    {
+        for (int o=0; o<_outputSize; o++)
+        {
+            double *row = output + o * S;
+            vDSP_vsmsaD(row, 1, _blob + _outputScaleOffset + o, _blob + _outputOffsetOffset + o,
+                        row, 1, S);
+        }
+    }
+}
+
+- (Matrix *)activateWithMatrix:(Matrix *)input
+{
+    NSAssert(input->rows == _inputSize, @"Input size mismatch");
+    Matrix *output = [Matrix matrixOfRows:_outputSize columns:input->columns];
+    [self activateValues:input->matrix output:output->matrix columns:input->columns];
+    return output;
+}
+
+@end
@@ -31,7 +31,16 @@
     self = [super initWithCoder:aDecoder];
     if (self)
     {
-        self.weightMatrix = [aDecoder decodeObjectForKey:@"weightMatrix"];
+        YCBlockSparseMatrix *sparse = [aDecoder decodeObjectForKey:@"sparseWeightMatrix"];
+        if (sparse)
+        {
+            self.weightMatrix = [[sparse denseMatrix] matrixByTransposing];
+            [self compressWeightsWithBlockSize:sparse.blockSize maximumDensity:1.0];
+        }
+        else
+        {
+            self.weightMatrix = [aDecoder decodeObjectForKey:@"weightMatrix"];
+        }
         self.biasVector = [aDecoder decodeObjectForKey:@"biasVector"];
         self.lastActivation = [aDecoder decodeObjectForKey:@"lastActivation"];
         self.L2 = [aDecoder decodeDoubleForKey:@"L2"];
@@ -42,7 +51,14 @@
 - (void)encodeWithCoder:(NSCoder *)aCoder
 {
     [super encodeWithCoder:aCoder];
-    [aCoder encodeObject:self.weightMatrix forKey:@"weightMatrix"];
+    if (self.sparseWeightMatrix)
+    {
+        [aCoder encodeObject:self.sparseWeightMatrix forKey:@"sparseWeightMatrix"];
+    }
+    else
+    {
+        [aCoder encodeObject:self.weightMatrix forKey:@"weightMatrix"];
+    }
     [aCoder encodeObject:self.biasVector forKey:@"biasVector"];
     [aCoder encodeObject:self.lastActivation forKey:@"lastActivation"];
     [aCoder encodeDouble:self.L2 forKey:@"L2"];
@@ -54,6 +70,10 @@
 {
     YCFullyConnectedLayer *copy = [super copyWithZone:zone];
     copy.weightMatrix = [self.weightMatrix copy];
+    if (self.sparseWeightMatrix)
+    {
+        [copy compressWeightsWithBlockSize:self.sparseWeightMatrix.blockSize maximumDensity:1.0];
+    }
     copy.biasVector = [self.biasVector copy];
     copy.L2 = self.L2;
     copy.lastActivation = [self.lastActivation copy];
@@ -121,13 +141,17 @@
         
         for (NSUInteger j = 0; j<self.inputSize; j++)
         {
+            double weight = [self.weightMatrix i:(int)j j:(int)i];
+            
+            // Pruned connections are omitted
+            if (weight == 0 && self.sparseWeightMatrix) continue;
+            
             NSXMLElement *con = [[NSXMLElement alloc] initWithName:@"Con"];
             
             NSString *cFrom = [NSString stringWithFormat:@"%lu,%lu", index-1, j];
             [con addAttribute:[NSXMLNode attributeWithName:@"from" stringValue:cFrom]];
             
-            NSString *cWeight = [NSString stringWithFormat:@"%f", [self.weightMatrix i:(int)j
-                                                                                      j:(int)i]];
+            NSString *cWeight = [NSString stringWithFormat:@"%f", weight];
             [con addAttribute:[NSXMLNode attributeWithName:@"weight" stringValue:cWeight]];
             
             [neuron addChild:con];
@@ -0,0 +1,94 @@
+//
+//  YCKernelRidgeModel+IO.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCKernelRidgeModel+IO.h"
+
+@implementation YCKernelRidgeModel (IO)
+
+#pragma mark - NSCopying Implementation
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+    // The feature map is not modified after training, and is shared with the copy
+    YCKernelRidgeModel *copy = [super copyWithZone:zone];
+    if (copy)
+    {
+        copy.featureMap = self.featureMap;
+        copy.weights = [self.weights copy];
+        copy.inputTransform = [self.inputTransform copy];
+        copy.outputTransform = [self.outputTransform copy];
+    }
+    return copy;
+}
+
+#pragma mark - NSCoding Implementation
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [super encodeWithCoder:aCoder];
+    [aCoder encodeObject:self.featureMap forKey:@"featureMap"];
+    [aCoder encodeObject:self.weights forKey:@"weights"];
+    [aCoder encodeObject:self.inputTransform forKey:@"inputTransform"];
+    [aCoder encodeObject:self.outputTransform forKey:@"outputTransform"];
+}
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if (self = [super initWithCoder:aDecoder])
+    {
+        self.featureMap = [aDecoder decodeObjectForKey:@"featureMap"];
+        self.weights = [aDecoder decodeObjectForKey:@"weights"];
+        self.inputTransform = [aDecoder decodeObjectForKey:@"inputTransform"];
+        self.outputTransform = [aDecoder decodeObjectForKey:@"outputTransform"];
+    }
+    return self;
+}
+
+#pragma mark - Text Description
+
+- (NSString *)textDescription
+{
+    NSMutableString *description = (NSMutableString *)[super textDescription];
+    
+    [description appendFormat:@"\nFeature Map is %@ (%d features)\n", [self.featureMap class],
+     self.weights.rows - 1];
+    
+    // Print input and output transform matrices
+    if (self.inputTransform)
+    {
+        [description appendFormat:@"\nInput Transform (%d x %d)\nMapping Function: y = c1*x + c2\n%@",self.inputTransform.rows,
+         self.inputTransform.columns, self.inputTransform];
+    }
+    if (self.outputTransform)
+    {
+        [description appendFormat:@"\nOutput Transform (%d x %d)\nMapping Function: y = c1*x + c2\n%@",self.outputTransform.rows,
+         self.outputTransform.columns, self.outputTransform];
+    }
+    
+    // Print output weights
+    [description appendFormat:@"\nOutput Weights (%d x %d)\n%@",self.weights.rows,
+     self.weights.columns, self.weights];
+    
+    return description;
+}
+
+@end
@@ -0,0 +1,123 @@
+//
+//  YCQuantizedModel+IO.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCQuantizedModel+IO.h"
+
+@implementation YCQuantizedModel (IO)
+
+#pragma mark - NSCopying Implementation
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+    // The quantized parameters are immutable, and are shared with the copy
+    YCQuantizedModel *copy = [super copyWithZone:zone];
+    if (copy)
+    {
+        copy->_layerInfo         = _layerInfo;
+        copy->_weights           = _weights;
+        copy->_biases            = _biases;
+        copy->_tables            = _tables;
+        copy->_inputQuantization = _inputQuantization;
+        copy->_outputTransform   = [_outputTransform copy];
+        copy->_outputActivation  = _outputActivation;
+    }
+    return copy;
+}
+
+#pragma mark - NSCoding Implementation
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [super encodeWithCoder:aCoder];
+    [aCoder encodeObject:[self layerInfoArray] forKey:@"layerInfo"];
+    [aCoder encodeObject:_weights forKey:@"weights"];
+    [aCoder encodeObject:_biases forKey:@"biases"];
+    [aCoder encodeObject:_tables forKey:@"tables"];
+    [aCoder encodeObject:_inputQuantization forKey:@"inputQuantization"];
+    [aCoder encodeObject:_outputTransform forKey:@"outputTransform"];
+    [aCoder encodeObject:_outputActivation forKey:@"outputActivation"];
+}
+
+- (id)initWithCoder:(NSCoder *)aDecoder
+{
+    if (self = [super initWithCoder:aDecoder])
+    {
+        _layerInfo         = [self layerInfoWithArray:[aDecoder decodeObjectForKey:@"layerInfo"]];
+        _weights           = [aDecoder decodeObjectForKey:@"weights"];
+        _biases            = [aDecoder decodeObjectForKey:@"biases"];
+        _tables            = [aDecoder decodeObjectForKey:@"tables"];
+        _inputQuantization = [aDecoder decodeObjectForKey:@"inputQuantization"];
+        _outputTransform   = [aDecoder decodeObjectForKey:@"outputTransform"];
+        _outputActivation  = [aDecoder decodeObjectForKey:@"outputActivation"];
+    }
+    return self;
+}
+
+// Layer descriptions are archived field by field, so that archives do not
+// depend on the memory layout of YCQuantizedLayer
+- (NSArray *)layerInfoArray
+{
+    NSMutableArray *array = [NSMutableArray array];
+    const YCQuantizedLayer *layers = _layerInfo.bytes;
+    for (int l=0; l<self.layerCount; l++)
+    {
+        const YCQuantizedLayer *layer = &layers[l];
+        [array addObject:@{@"inputSize"    : @(layer->inputSize),
+                           @"outputSize"   : @(layer->outputSize),
+                           @"weightOffset" : @(layer->weightOffset),
+                           @"biasOffset"   : @(layer->biasOffset),
+                           @"tableOffset"  : @(layer->tableOffset),
+                           @"zeroPoint"    : @(layer->zeroPoint),
+                           @"multiplier"   : @(layer->multiplier)}];
+    }
+    return array;
+}
+
+- (NSData *)layerInfoWithArray:(NSArray *)array
+{
+    NSMutableData *layerInfo = [NSMutableData dataWithLength:array.count * sizeof(YCQuantizedLayer)];
+    YCQuantizedLayer *layers = layerInfo.mutableBytes;
+    [array enumerateObjectsUsingBlock:^(NSDictionary *fields, NSUInteger idx, BOOL *stop) {
+        YCQuantizedLayer *layer = &layers[idx];
+        layer->inputSize    = [fields[@"inputSize"] intValue];
+        layer->outputSize   = [fields[@"outputSize"] intValue];
+        layer->weightOffset = [fields[@"weightOffset"] intValue];
+        layer->biasOffset   = [fields[@"biasOffset"] intValue];
+        layer->tableOffset  = [fields[@"tableOffset"] intValue];
+        layer->zeroPoint    = [fields[@"zeroPoint"] intValue];
+        layer->multiplier   = [fields[@"multiplier"] doubleValue];
+    }];
+    return layerInfo;
+}
+
+#pragma mark - Text Description
+
+- (NSString *)textDescription
+{
+    NSMutableString *description = (NSMutableString *)[super textDescription];
+    [description appendFormat:@"\nInt8 quantized model with %d layers (%lu parameter bytes)\n",
+     self.layerCount, (unsigned long)self.parameterBytes];
+    [description appendFormat:@"Output activation is %@\n", [_outputActivation class]];
+    return description;
+}
+
+@end
@@ -21,6 +21,7 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 #import "YCKPM.h"
+@import YCMatrix;
 
 @implementation YCKPM
 
@@ -28,23 +29,23 @@
 {
     double bias = MAX(1E-12, [self.trainingSettings[@"Bias"] doubleValue]);
     
-    // 1. Scale input
-    Matrix *scaledInput = matrix;
-    if (self.inputTransform)
-    {
-        scaledInput = [matrix matrixByRowWiseMapUsing:self.inputTransform];
-    }
-    
-    // 2. Prepare output matrix and split input matrix to columns
+    // 1. Prepare output matrix
     //    TODO: Vectorize this!
-    Matrix *output = [Matrix matrixOfRows:self.targets.rows columns:scaledInput.columns];
-    NSArray *examples = [scaledInput columnsAsNSArray];
+    int N = matrix->rows;
+    int S = matrix->columns;
+    Matrix *output = [Matrix matrixOfRows:self.targets.rows columns:S];
+    Matrix *example = [Matrix matrixOfRows:N columns:1];
+    double *transform = self.inputTransform ? self.inputTransform->matrix : NULL;
     
-    // 3. For each example: Find similarity with prototypes; weigh each
-    //    prototype's corresponding target and sum them up together
-    for (int i=0; i<examples.count; i++)
+    // 2. For each example: Scale on the fly; find similarity with prototypes;
+    //    weigh each prototype's corresponding target and sum them up together
+    for (int i=0; i<S; i++)
     {
-        Matrix *example = examples[i];
+        for (int k=0; k<N; k++)
+        {
+            double value = matrix->matrix[k*S + i];
+            example->matrix[k] = transform ? value * transform[2*k] + transform[2*k + 1] : value;
+        }
         Matrix *diff = [self.prototypes matrixBySubtractingColumn:example];
         [diff square];
         Matrix *weights = [diff sumsOfColumns];
@@ -59,7 +60,7 @@
         [output setColumn:i value:singleOutput];
     }
     
-    // 4. Reverse-scale output and return
+    // 3. Reverse-scale output and return
     if (self.outputTransform)
     {
         return [output matrixByRowWiseMapUsing:self.outputTransform];
@@ -67,4 +68,16 @@
     return output;
 }
 
+- (void)foldTransforms
+{
+    if (!self.targets || !self.outputTransform) return;
+    
+    // Output is a convex combination of targets, hence
+    // y' = c.*y + d => targets' = c.*targets + d
+    self.targets = [self.targets matrixByRowWiseMapUsing:self.outputTransform];
+    self.outputTransform = nil;
+    
+    // The input transform is applied on the fly during activation
+}
+
 @end
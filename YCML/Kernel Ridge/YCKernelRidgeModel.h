@@ -0,0 +1,55 @@
+//
+//  YCKernelRidgeModel.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCSupervisedModel.h"
+@class Matrix, YCKernelFeatureMap;
+
+/**
+ Approximate kernel ridge regression model. Samples are mapped through an
+ explicit kernel feature map, and the output is a linear function of the
+ features, hence inference cost per sample is independent of the number
+ of training samples.
+ */
+@interface YCKernelRidgeModel : YCSupervisedModel
+
+/**
+ Returns the feature map of the receiver.
+ */
+@property YCKernelFeatureMap *featureMap;
+
+/**
+ Returns the output weights of the receiver ((D+1)xO); the last row holds
+ the bias.
+ */
+@property Matrix *weights;
+
+/**
+ Returns the input transformation matrix of the receiver.
+ */
+@property Matrix *inputTransform;
+
+/**
+ Returns the output reverse transformation matrix of the receiver.
+ */
+@property Matrix *outputTransform;
+
+@end
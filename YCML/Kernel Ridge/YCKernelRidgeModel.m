@@ -0,0 +1,103 @@
+//
+//  YCKernelRidgeModel.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+// N: Size of input
+// D: Number of features
+// S: Number of samples
+// O: Size of output
+
+// Maximum number of feature values held per chunk during activation
+#define FEATURE_TILE_ELEMENTS 65536
+
+#import "YCKernelRidgeModel.h"
+#import "YCKernelFeatureMap.h"
+@import YCMatrix;
+@import Accelerate;
+
+@implementation YCKernelRidgeModel
+
+- (Matrix *)activateWithMatrix:(Matrix *)matrix
+{
+    NSAssert(self.weights, @"Model not trained");
+    NSAssert([matrix rows] == self.inputSize, @"Input size mismatch");
+    
+    int D = self.weights->rows - 1;
+    int O = self.weights->columns;
+    int S = matrix->columns;
+    Matrix *output = [Matrix matrixOfRows:O columns:S];
+    if (S == 0) return output;
+    
+    // Input columns are mapped in chunks that are processed concurrently
+    int threads = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+    int chunk = MAX(1, MIN(FEATURE_TILE_ELEMENTS / D, (S + threads - 1) / threads));
+    int chunkCount = (S + chunk - 1) / chunk;
+    
+    YCKernelFeatureMap *featureMap = self.featureMap;
+    Matrix *inputTransform = self.inputTransform;
+    const double *weights = self.weights->matrix;
+    const double *bias = weights + D * O;
+    double *o = output->matrix;
+    
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t c) {
+        @autoreleasepool
+        {
+            NSRange range = NSMakeRange(c * chunk, MIN(chunk, S - (int)c * chunk));
+            int n = (int)range.length;
+            
+            // 1. Scale input and map to features
+            Matrix *scaledInput = [matrix matrixWithColumnsInRange:range];
+            if (inputTransform)
+            {
+                scaledInput = [scaledInput matrixByRowWiseMapUsing:inputTransform];
+            }
+            Matrix *features = [featureMap featuresForMatrix:scaledInput]; // DxC
+            
+            // 2. Output = W' * Z + bias, written to the chunk's columns
+            double *out = o + range.location;
+            for (int i=0; i<O; i++)
+            {
+                vDSP_vfillD(&bias[i], out + i * S, 1, n);
+            }
+            cblas_dgemm(CblasRowMajor, CblasTrans, CblasNoTrans, O, n, D,
+                        1.0, weights, O, features->matrix, n, 1.0, out, S);
+        }
+    });
+    
+    // 3. Scale output and return
+    if (self.outputTransform)
+    {
+        return [output matrixByRowWiseMapUsing:self.outputTransform];
+    }
+    return output;
+}
+
+- (int)inputSize
+{
+    return self.featureMap.inputSize;
+}
+
+- (int)outputSize
+{
+    return self.weights.columns;
+}
+
+@end
@@ -0,0 +1,46 @@
+//
+//  YCKernelRidgeTrainer.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCSupervisedTrainer.h"
+
+/**
+ Approximate kernel ridge regression trainer. Samples are mapped through
+ an explicit kernel feature map, and the output weights are found in
+ closed form, by accumulating the (D+1)x(D+1) and (D+1)xO terms of the
+ regularized normal equations over column chunks of "Chunk Size" and
+ solving through a Cholesky factorization. Training time is linear, and
+ memory constant, in the number of samples.
+ 
+ The following settings are supported:
+ 
+ - Kernel:        RBF or Linear (default RBF).
+ - Beta:          The width of the RBF kernel (default 1.0).
+ - Approximation: Fourier, for Random Fourier Features (RBF kernel only),
+                  or Nystrom, for a Nyström map with randomly selected
+                  training samples as landmarks (default Fourier).
+ - Features:      The number of features or landmarks (default 300).
+ - Lambda:        The ridge regularization factor (default 1E-4).
+ - Chunk Size:    The number of samples mapped at a time (default 1000).
+ */
+@interface YCKernelRidgeTrainer : YCSupervisedTrainer
+
+@end
@@ -0,0 +1,153 @@
+//
+//  YCKernelRidgeTrainer.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+// N: Size of input
+// D: Number of features
+// S: Number of samples
+// O: Size of output
+
+#import "YCKernelRidgeTrainer.h"
+#import "YCKernelRidgeModel.h"
+#import "YCKernelFeatureMap.h"
+#import "YCLinearKernel.h"
+#import "YCRBFKernel.h"
+#import "Matrix+Cholesky.h"
+@import YCMatrix;
+@import Accelerate;
+
+@implementation YCKernelRidgeTrainer
+
++ (Class)modelClass
+{
+    return [YCKernelRidgeModel class];
+}
+
+-(id)init
+{
+    if (self = [super init])
+    {
+        self.settings[@"Kernel"]            = @"RBF"; // Linear, RBF
+        self.settings[@"Beta"]              = @1.0; // For RBF kernels
+        self.settings[@"Approximation"]     = @"Fourier"; // Fourier, Nystrom
+        self.settings[@"Features"]          = @300;
+        self.settings[@"Lambda"]            = @1E-4;
+        self.settings[@"Chunk Size"]        = @1000;
+    }
+    return self;
+}
+
+- (void)performTrainingModel:(YCKernelRidgeModel *)model
+                 inputMatrix:(Matrix *)input
+                outputMatrix:(Matrix *)output
+{
+    // Input: NxS, output: OxS
+    
+    // Step I. Scaling inputs & outputs; determining inverse output scaling matrix
+    YCDomain domain = YCMakeDomain(-1, 1);
+    Matrix *inputTransform  = [input rowWiseMapToDomain:domain basis:MinMax];
+    Matrix *outputTransform = [output rowWiseMapToDomain:domain basis:MinMax];
+    Matrix *invOutTransform = [output rowWiseInverseMapFromDomain:domain basis:MinMax];
+    
+    int N                   = input->rows;
+    int S                   = input->columns;
+    int O                   = output->rows;
+    int featureCount        = MAX(1, [self.settings[@"Features"] intValue]);
+    int chunkSize           = MAX(1, [self.settings[@"Chunk Size"] intValue]);
+    double lambda           = [self.settings[@"Lambda"] doubleValue];
+    
+    // Step II. Feature map
+    YCModelKernel *kernel;
+    if ([self.settings[@"Kernel"] isEqualToString:@"RBF"])
+    {
+        kernel = [[YCRBFKernel alloc] init];
+        kernel.properties[@"Beta"] = self.settings[@"Beta"];
+    }
+    else
+    {
+        kernel = [[YCLinearKernel alloc] init];
+    }
+    
+    YCKernelFeatureMap *featureMap;
+    if ([self.settings[@"Approximation"] isEqualToString:@"Fourier"] &&
+        [kernel isKindOfClass:[YCRBFKernel class]])
+    {
+        featureMap = [(YCRBFKernel *)kernel randomFourierFeatureMapWithInputSize:N
+                                                                    featureCount:featureCount];
+    }
+    else
+    {
+        // Landmarks are distinct training samples, selected at random
+        int L = MIN(featureCount, S);
+        int *indexes = malloc(S * sizeof(int));
+        for (int i=0; i<S; i++) indexes[i] = i;
+        Matrix *landmarks = [Matrix matrixOfRows:N columns:L];
+        for (int l=0; l<L; l++)
+        {
+            int r = l + arc4random_uniform(S - l);
+            int t = indexes[l];
+            indexes[l] = indexes[r];
+            indexes[r] = t;
+            Matrix *sample = [[input column:indexes[l]] matrixByRowWiseMapUsing:inputTransform];
+            [landmarks setColumn:l value:sample];
+        }
+        free(indexes);
+        featureMap = [kernel nystromFeatureMapWithLandmarks:landmarks];
+    }
+    
+    // Step III. Accumulating Z * Z' (upper triangle) and Z * Y' chunk by
+    // chunk, where Z is augmented with a row of ones for the bias
+    int D = featureMap.featureCount;
+    Matrix *gram = [Matrix matrixOfRows:D + 1 columns:D + 1];
+    Matrix *projection = [Matrix matrixOfRows:D + 1 columns:O];
+    for (int c0=0; c0<S; c0+=chunkSize)
+    {
+        if (self.shouldStop) return;
+        NSRange range = NSMakeRange(c0, MIN(chunkSize, S - c0));
+        int c = (int)range.length;
+        Matrix *scaledInput  = [[input matrixWithColumnsInRange:range]
+                                matrixByRowWiseMapUsing:inputTransform];
+        Matrix *scaledOutput = [[output matrixWithColumnsInRange:range]
+                                matrixByRowWiseMapUsing:outputTransform];
+        Matrix *features = [[featureMap featuresForMatrix:scaledInput]
+                            appendRow:[Matrix matrixOfRows:1 columns:c value:1]];
+        
+        cblas_dsyrk(CblasRowMajor, CblasUpper, CblasNoTrans, D + 1, c,
+                    1.0, features->matrix, c, 1.0, gram->matrix, D + 1);
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, D + 1, O, c,
+                    1.0, features->matrix, c, scaledOutput->matrix, c, 1.0, projection->matrix, O);
+    }
+    
+    // Step IV. Solving (Z * Z' + lambda * I) W = Z * Y'; the bias is not
+    // regularized
+    for (int i=0; i<D; i++)
+    {
+        gram->matrix[i * (D + 2)] += lambda;
+    }
+    
+    model.featureMap      = featureMap;
+    model.weights         = [gram matrixBySolvingSymmetric:projection regularization:0];
+    model.inputTransform  = inputTransform;
+    model.outputTransform = invOutTransform;
+    model.statistics[@"Features"] = @(D);
+}
+
+@end
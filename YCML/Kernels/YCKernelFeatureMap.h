@@ -0,0 +1,53 @@
+//
+//  YCKernelFeatureMap.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+@class Matrix;
+
+/**
+ The base class for explicit, approximate kernel feature maps. A feature
+ map z() is such that z(x)'z(y) approximates the kernel value K(x, y), so
+ that kernel machines can be trained as linear models on the mapped
+ samples, in time linear in the number of samples.
+ */
+@interface YCKernelFeatureMap : NSObject <NSCoding>
+
+/**
+ Returns the features of each column of |matrix|.
+ 
+ @param matrix The input samples (NxS), one per column.
+ 
+ @return The features (DxS), one column per sample.
+ */
+- (Matrix *)featuresForMatrix:(Matrix *)matrix;
+
+/**
+ Returns the size of the samples accepted by the receiver.
+ */
+@property (readonly) int inputSize;
+
+/**
+ Returns the number of features produced per sample.
+ */
+@property (readonly) int featureCount;
+
+@end
@@ -22,13 +22,41 @@
 
 #import "YCLinearKernel.h"
 @import YCMatrix;
+@import Accelerate;
 
 @implementation YCLinearKernel
 
 - (Matrix *)kernelValueForA:(Matrix *)a b:(Matrix *)b
 {
     // a: NxP, b: NxQ -> out: PxQ
-    return [a matrixByTransposingAndMultiplyingWithRight:b];
+    Matrix *values = [Matrix matrixOfRows:a->columns columns:b->columns];
+    [self kernelValueForA:a b:b into:values->matrix];
+    return values;
+}
+
+- (void)kernelValueForA:(Matrix *)a b:(Matrix *)b into:(double *)values
+{
+    // a'b, in tiles of output rows
+    int N = a->rows;
+    int P = a->columns;
+    int Q = b->columns;
+    if (P == 0 || Q == 0) return;
+    YCKernelApplyToTiles(P, Q, ^(int p0, int tp) {
+        cblas_dgemm(CblasRowMajor, CblasTrans, CblasNoTrans, tp, Q, N,
+                    1.0, a->matrix + p0, P, b->matrix, Q, 0.0, values + p0 * Q, Q);
+    });
+}
+
+- (void)kernelValuesForA:(Matrix *)a vector:(const double *)vector into:(double *)values
+{
+    // a: NxP -> values = a' * vector (P)
+    cblas_dgemv(CblasRowMajor, CblasTrans, a->rows, a->columns, 1.0, a->matrix, a->columns,
+                vector, 1, 0.0, values, 1);
+}
+
+- (double)kernelValueForVector:(const double *)a vector:(const double *)b length:(int)length
+{
+    return cblas_ddot(length, a, 1, b, 1);
 }
 
 @end
@@ -21,17 +21,85 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 @import Foundation;
-@class Matrix;
+@class Matrix, YCKernelFeatureMap;
 
-@interface YCModelKernel : NSObject
+@interface YCModelKernel : NSObject <NSCoding>
 
 + (instancetype)kernel;
 
+/**
+ Returns the kernel values of each column of |a| against each column of
+ |b|.
+ 
+ @param a The first matrix of samples (NxP1), one per column.
+ @param b The second matrix of samples (NxP2), one per column.
+ 
+ @return The kernel matrix (P1xP2).
+ */
 - (Matrix *)kernelValueForA:(Matrix *)a b:(Matrix *)b;
 
+/**
+ Computes the kernel values of each column of |a| against each column of
+ |b|, writing them to a caller-provided, row-major P1xP2 buffer. Subclasses
+ override it with an implementation based on a single matrix product
+ (distances or inner products), followed by a vectorized transform, that
+ runs concurrently over tiles of output rows. The default implementation
+ calls kernelValueForA:b: and copies the result.
+ 
+ @param a      The first matrix of samples (NxP1), one per column.
+ @param b      The second matrix of samples (NxP2), one per column.
+ @param values Pointer to the output buffer (P1xP2 values).
+ */
+- (void)kernelValueForA:(Matrix *)a b:(Matrix *)b into:(double *)values;
+
+/**
+ Computes the kernel values of each column of |a| against a single vector,
+ writing them to a caller-provided buffer. This is the primitive used for
+ filling kernel rows; subclasses override it with an implementation that
+ does not allocate matrices. The default implementation wraps the vector
+ and calls kernelValueForA:b:.
+ 
+ @param a      The matrix of samples (NxP), one per column.
+ @param vector Pointer to the contiguous vector (N values).
+ @param values Pointer to the output buffer (P values).
+ */
+- (void)kernelValuesForA:(Matrix *)a vector:(const double *)vector into:(double *)values;
+
+/**
+ Returns the kernel value of two contiguous vectors. This is the primitive
+ used for single kernel values; subclasses override it with an
+ implementation that does not allocate matrices. The default
+ implementation wraps the vectors and calls kernelValueForA:b:.
+ 
+ @param a      Pointer to the first vector (|length| values).
+ @param b      Pointer to the second vector (|length| values).
+ @param length The number of values in each vector.
+ 
+ @return The kernel value.
+ */
+- (double)kernelValueForVector:(const double *)a vector:(const double *)b length:(int)length;
+
+/**
+ Returns a Nyström feature map approximating the receiver, with
+ |landmarks| as the landmark samples.
+ 
+ @param landmarks The landmark samples (NxL), one per column.
+ 
+ @return The feature map.
+ */
+- (YCKernelFeatureMap *)nystromFeatureMapWithLandmarks:(Matrix *)landmarks;
+
 /**
  Holds kernel properties.
  */
 @property NSMutableDictionary *properties;
 
 @end
+
+/**
+ Splits the |rows| rows of a kernel matrix with |columns| columns in tiles
+ of bounded size, and calls |block| concurrently for each tile with the
+ first row and the number of rows of the tile. Used by subclasses for
+ evaluating kernel matrices.
+ */
+void YCKernelApplyToTiles(int rows, int columns, void (^block)(int firstRow, int rowCount));
@@ -21,6 +21,27 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 #import "YCModelKernel.h"
+#import "YCNystromFeatures.h"
+@import YCMatrix;
+
+// Target number of kernel values per tile, when evaluating kernel matrices
+#define TILE_ELEMENTS 16384
+
+void YCKernelApplyToTiles(int rows, int columns, void (^block)(int firstRow, int rowCount))
+{
+    int threads = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+    int tileRows = MAX(1, MIN(TILE_ELEMENTS / MAX(columns, 1), (rows + threads - 1) / threads));
+    int tileCount = (rows + tileRows - 1) / tileRows;
+    if (tileCount == 1)
+    {
+        block(0, rows);
+        return;
+    }
+    dispatch_apply(tileCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t t) {
+        int r0 = (int)t * tileRows;
+        block(r0, MIN(tileRows, rows - r0));
+    });
+}
 
 @implementation YCModelKernel
 
@@ -49,10 +70,40 @@
     return self;
 }
 
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeObject:self.properties forKey:@"properties"];
+}
+
 - (Matrix *)kernelValueForA:(Matrix *)a b:(Matrix *)b
 {
     @throw [NSInternalInconsistencyException initWithFormat:
             @"You must override %@ in subclass %@", NSStringFromSelector(_cmd), [self class]];
 }
 
+- (void)kernelValueForA:(Matrix *)a b:(Matrix *)b into:(double *)values
+{
+    Matrix *k = [self kernelValueForA:a b:b];
+    memcpy(values, k->matrix, a->columns * b->columns * sizeof(double));
+}
+
+- (void)kernelValuesForA:(Matrix *)a vector:(const double *)vector into:(double *)values
+{
+    Matrix *b = [Matrix matrixFromArray:(double *)vector rows:a->rows columns:1 mode:YCMWeak];
+    Matrix *k = [self kernelValueForA:a b:b];
+    memcpy(values, k->matrix, a->columns * sizeof(double));
+}
+
+- (double)kernelValueForVector:(const double *)a vector:(const double *)b length:(int)length
+{
+    Matrix *aVector = [Matrix matrixFromArray:(double *)a rows:length columns:1 mode:YCMWeak];
+    Matrix *bVector = [Matrix matrixFromArray:(double *)b rows:length columns:1 mode:YCMWeak];
+    return [self kernelValueForA:aVector b:bVector]->matrix[0];
+}
+
+- (YCKernelFeatureMap *)nystromFeatureMapWithLandmarks:(Matrix *)landmarks
+{
+    return [[YCNystromFeatures alloc] initWithKernel:self landmarks:landmarks];
+}
+
 @end
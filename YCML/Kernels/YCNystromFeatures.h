@@ -0,0 +1,60 @@
+//
+//  YCNystromFeatures.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCKernelFeatureMap.h"
+@class YCModelKernel;
+
+/**
+ Nyström feature map for any kernel. With L landmark samples and their
+ kernel matrix K_LL = U Λ U', z(x) = Λ^(-1/2) U' k_L(x), where k_L(x) holds
+ the kernel values of x against the landmarks. Eigenvalues that are
+ negligible relative to the largest one are dropped, hence the number of
+ features may be less than the number of landmarks.
+ */
+@interface YCNystromFeatures : YCKernelFeatureMap
+
+/**
+ Initializes a Nyström feature map of |kernel|, with |landmarks|.
+ 
+ @param kernel    The kernel.
+ @param landmarks The landmark samples (NxL), one per column.
+ 
+ @return The feature map.
+ */
+- (instancetype)initWithKernel:(YCModelKernel *)kernel landmarks:(Matrix *)landmarks;
+
+/**
+ Returns the kernel of the receiver.
+ */
+@property (readonly) YCModelKernel *kernel;
+
+/**
+ Returns the landmark samples (NxL).
+ */
+@property (readonly) Matrix *landmarks;
+
+/**
+ Returns the projection Λ^(-1/2) U' (DxL).
+ */
+@property (readonly) Matrix *projection;
+
+@end
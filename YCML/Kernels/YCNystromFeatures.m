@@ -0,0 +1,128 @@
+//
+//  YCNystromFeatures.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+// N: Size of input
+// L: Number of landmarks
+// D: Number of features
+// S: Number of samples
+
+#define EIGENVALUE_TOLERANCE 1E-10
+
+#import "YCNystromFeatures.h"
+#import "YCModelKernel.h"
+@import YCMatrix;
+@import Accelerate;
+
+@implementation YCNystromFeatures
+
+- (instancetype)initWithKernel:(YCModelKernel *)kernel landmarks:(Matrix *)landmarks
+{
+    self = [super init];
+    if (self)
+    {
+        _kernel = kernel;
+        _landmarks = landmarks;
+        
+        // Eigendecomposition of the (symmetric) landmark kernel matrix; the
+        // row-major eigenvector rows returned by LAPACK are the columns of U
+        int L = landmarks->columns;
+        Matrix *K = [kernel kernelValueForA:landmarks b:landmarks];
+        double *eigenvalues = malloc(L * sizeof(double));
+        char jobz = 'V';
+        char uplo = 'U';
+        __CLPK_integer n = L, lwork = -1, info;
+        double workSize;
+        dsyev_(&jobz, &uplo, &n, K->matrix, &n, eigenvalues, &workSize, &lwork, &info);
+        lwork = (__CLPK_integer)workSize;
+        double *work = malloc(lwork * sizeof(double));
+        dsyev_(&jobz, &uplo, &n, K->matrix, &n, eigenvalues, work, &lwork, &info);
+        free(work);
+        NSAssert(info == 0, @"Eigendecomposition of the landmark kernel matrix failed");
+        
+        // Eigenvalues are in ascending order; negligible ones are dropped
+        double threshold = eigenvalues[L - 1] * EIGENVALUE_TOLERANCE;
+        int first = 0;
+        while (first < L - 1 && eigenvalues[first] <= threshold) first++;
+        int D = L - first;
+        
+        Matrix *projection = [Matrix matrixOfRows:D columns:L];
+        for (int d=0; d<D; d++)
+        {
+            double factor = 1.0 / sqrt(eigenvalues[first + d]);
+            vDSP_vsmulD(K->matrix + (first + d) * L, 1, &factor,
+                        projection->matrix + d * L, 1, L);
+        }
+        _projection = projection;
+        free(eigenvalues);
+    }
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super initWithCoder:aDecoder];
+    if (self)
+    {
+        _kernel     = [aDecoder decodeObjectForKey:@"kernel"];
+        _landmarks  = [aDecoder decodeObjectForKey:@"landmarks"];
+        _projection = [aDecoder decodeObjectForKey:@"projection"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [super encodeWithCoder:aCoder];
+    [aCoder encodeObject:_kernel forKey:@"kernel"];
+    [aCoder encodeObject:_landmarks forKey:@"landmarks"];
+    [aCoder encodeObject:_projection forKey:@"projection"];
+}
+
+- (Matrix *)featuresForMatrix:(Matrix *)matrix
+{
+    NSAssert(matrix->rows == self.inputSize, @"Input size mismatch");
+    int L = _landmarks->columns;
+    int D = _projection->rows;
+    int S = matrix->columns;
+    Matrix *features = [Matrix matrixOfRows:D columns:S];
+    if (S == 0) return features;
+    
+    // Z = P * K(landmarks, X), (DxL) * (LxS)
+    double *k = malloc(L * S * sizeof(double));
+    [_kernel kernelValueForA:_landmarks b:matrix into:k];
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, D, S, L,
+                1.0, _projection->matrix, L, k, S, 0.0, features->matrix, S);
+    free(k);
+    return features;
+}
+
+- (int)inputSize
+{
+    return _landmarks->rows;
+}
+
+- (int)featureCount
+{
+    return _projection->rows;
+}
+
+@end
@@ -22,6 +22,23 @@
 
 #import "YCModelKernel.h"
 
+/**
+ Gaussian radial basis function kernel, K(a, b) = exp(-|s.*(a - b)|^2 / Beta^2).
+ The "Beta" property holds the kernel width. The optional "Scale" property
+ holds an Nx1 matrix of per-dimension scale factors s, that are applied to
+ the difference vector on the fly.
+ */
 @interface YCRBFKernel : YCModelKernel
 
+/**
+ Returns a Random Fourier Feature map approximating the receiver.
+ 
+ @param inputSize    The size of the input samples.
+ @param featureCount The number of features.
+ 
+ @return The feature map.
+ */
+- (YCKernelFeatureMap *)randomFourierFeatureMapWithInputSize:(int)inputSize
+                                                featureCount:(int)featureCount;
+
 @end
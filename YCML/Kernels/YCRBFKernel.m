@@ -21,7 +21,9 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 #import "YCRBFKernel.h"
+#import "YCRandomFourierFeatures.h"
 @import YCMatrix;
+@import Accelerate;
 
 // N: Size of input
 // P1: Number of samples 1
@@ -42,32 +44,121 @@
 - (Matrix *)kernelValueForA:(Matrix *)a b:(Matrix *)b
 {
     // a: NxP1, b: NxP2 -> out: P1xP2
+    Matrix *values = [Matrix matrixOfRows:a->columns columns:b->columns];
+    [self kernelValueForA:a b:b into:values->matrix];
+    return values;
+}
+
+- (void)kernelValueForA:(Matrix *)a b:(Matrix *)b into:(double *)values
+{
+    // |s.*(x - y)|^2 = |s.*x|^2 + |s.*y|^2 - 2 (s.*x)'(s.*y), where the last
+    // term is computed for all pairs through a single matrix product
     double beta2 = pow([self.properties[@"Beta"] doubleValue], 2);
+    Matrix *scaleVector = self.properties[@"Scale"];
     
-    int N = a.rows;
-    int P1 = a.columns;
-    int P2 = b.columns;
+    int N = a->rows;
+    int P1 = a->columns;
+    int P2 = b->columns;
+    if (P1 == 0 || P2 == 0) return;
     
-    // Generate design matrix of dimensions SxD
-    Matrix *designmatrix = [Matrix matrixOfRows:P1 columns:P2]; // -> SxD
+    if (scaleVector)
+    {
+        a = [a matrixByRowWiseMapUsing:[YCRBFKernel scaleTransform:scaleVector]];
+        b = [b matrixByRowWiseMapUsing:[YCRBFKernel scaleTransform:scaleVector]];
+    }
     
-    // Fill up the design matrix, traversing first row and then column
-    for (int i=0; i<P1; i++)
+    double *normsA = calloc(P1, sizeof(double));
+    double *normsB = calloc(P2, sizeof(double));
+    for (int k=0; k<N; k++)
     {
-        for (int j=0; j<P2; j++)
+        vDSP_vmaD(a->matrix + k * P1, 1, a->matrix + k * P1, 1, normsA, 1, normsA, 1, P1);
+        vDSP_vmaD(b->matrix + k * P2, 1, b->matrix + k * P2, 1, normsB, 1, normsB, 1, P2);
+    }
+    
+    double factor = -1.0 / beta2;
+    double zero = 0;
+    double *ma = a->matrix;
+    double *mb = b->matrix;
+    YCKernelApplyToTiles(P1, P2, ^(int p0, int tp) {
+        double *tile = values + p0 * P2;
+        cblas_dgemm(CblasRowMajor, CblasTrans, CblasNoTrans, tp, P2, N,
+                    -2.0, ma + p0, P1, mb, P2, 0.0, tile, P2);
+        for (int i=0; i<tp; i++)
         {
-           double sqsum = 0;
-           double val;
-           for (int k=0; k<N; k++)
-           {
-               val = a->matrix[k*P1 + i] - b->matrix[k*P2 + j];
-               sqsum += val*val;
-           }
-           double bfvalue = exp( - sqsum / beta2 );
-           designmatrix->matrix[i*P2 + j] = bfvalue;
+            double *row = tile + i * P2;
+            vDSP_vsaddD(row, 1, &normsA[p0 + i], row, 1, P2);
+            vDSP_vaddD(row, 1, normsB, 1, row, 1, P2);
         }
+        int count = tp * P2;
+        
+        // Rounding may leave small negative distances
+        vDSP_vthrD(tile, 1, &zero, tile, 1, count);
+        vDSP_vsmulD(tile, 1, &factor, tile, 1, count);
+        vvexp(tile, tile, &count);
+    });
+    
+    free(normsA);
+    free(normsB);
+}
+
++ (Matrix *)scaleTransform:(Matrix *)scale
+{
+    // Row-wise map transform [s, 0]
+    Matrix *transform = [Matrix matrixOfRows:scale->rows columns:2];
+    cblas_dcopy(scale->rows, scale->matrix, 1, transform->matrix, 2);
+    return transform;
+}
+
+- (void)kernelValuesForA:(Matrix *)a vector:(const double *)vector into:(double *)values
+{
+    // a: NxP -> values: P
+    // Each row of a is contiguous, so squared differences are accumulated
+    // one dimension at a time over all samples
+    double beta2 = pow([self.properties[@"Beta"] doubleValue], 2);
+    Matrix *scaleVector = self.properties[@"Scale"];
+    double *scale = scaleVector ? scaleVector->matrix : NULL;
+    
+    int N = a->rows;
+    int P = a->columns;
+    double *difference = malloc(P * sizeof(double));
+    vDSP_vclrD(values, 1, P);
+    for (int k=0; k<N; k++)
+    {
+        double offset = -vector[k];
+        double weight = scale ? scale[k] * scale[k] : 1.0;
+        vDSP_vsaddD(a->matrix + k * P, 1, &offset, difference, 1, P);
+        vDSP_vsqD(difference, 1, difference, 1, P);
+        vDSP_vsmaD(difference, 1, &weight, values, 1, values, 1, P);
+    }
+    free(difference);
+    
+    double factor = -1.0 / beta2;
+    vDSP_vsmulD(values, 1, &factor, values, 1, P);
+    vvexp(values, values, &P);
+}
+
+- (double)kernelValueForVector:(const double *)a vector:(const double *)b length:(int)length
+{
+    double beta2 = pow([self.properties[@"Beta"] doubleValue], 2);
+    Matrix *scaleVector = self.properties[@"Scale"];
+    double *scale = scaleVector ? scaleVector->matrix : NULL;
+    
+    double sqsum = 0;
+    for (int k=0; k<length; k++)
+    {
+        double difference = a[k] - b[k];
+        double weight = scale ? scale[k] * scale[k] : 1.0;
+        sqsum += weight * difference * difference;
     }
-    return designmatrix;
+    return exp(-sqsum / beta2);
+}
+
+- (YCKernelFeatureMap *)randomFourierFeatureMapWithInputSize:(int)inputSize
+                                                featureCount:(int)featureCount
+{
+    return [[YCRandomFourierFeatures alloc] initWithKernel:self
+                                                 inputSize:inputSize
+                                              featureCount:featureCount];
 }
 
 @end
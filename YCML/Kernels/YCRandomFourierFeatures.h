@@ -0,0 +1,57 @@
+//
+//  YCRandomFourierFeatures.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCKernelFeatureMap.h"
+@class YCRBFKernel;
+
+/**
+ Random Fourier Features (Rahimi & Recht) for the RBF kernel,
+ z(x) = sqrt(2/D) cos(W x + b), with the rows of W drawn from the
+ spectral density of the kernel and b uniformly from [0, 2π]. The
+ per-dimension "Scale" of the kernel, if any, is folded into W.
+ */
+@interface YCRandomFourierFeatures : YCKernelFeatureMap
+
+/**
+ Initializes a random feature map approximating |kernel|.
+ 
+ @param kernel       The RBF kernel.
+ @param inputSize    The size of the input samples.
+ @param featureCount The number of features (D).
+ 
+ @return The feature map.
+ */
+- (instancetype)initWithKernel:(YCRBFKernel *)kernel
+                     inputSize:(int)inputSize
+                  featureCount:(int)featureCount;
+
+/**
+ Returns the random frequencies (DxN).
+ */
+@property (readonly) Matrix *frequencies;
+
+/**
+ Returns the random phases (Dx1).
+ */
+@property (readonly) Matrix *phases;
+
+@end
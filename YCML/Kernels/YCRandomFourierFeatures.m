@@ -0,0 +1,119 @@
+//
+//  YCRandomFourierFeatures.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+// N: Size of input
+// D: Number of features
+// S: Number of samples
+
+#import "YCRandomFourierFeatures.h"
+#import "YCRBFKernel.h"
+@import YCMatrix;
+@import Accelerate;
+
+@implementation YCRandomFourierFeatures
+
+- (instancetype)initWithKernel:(YCRBFKernel *)kernel
+                     inputSize:(int)inputSize
+                  featureCount:(int)featureCount
+{
+    self = [super init];
+    if (self)
+    {
+        // K(x, y) = exp(-|s.*(x - y)|^2 / beta^2) is a Gaussian kernel with
+        // variance beta^2 / 2, whose spectral density is N(0, 2 / beta^2)
+        double beta = [kernel.properties[@"Beta"] doubleValue];
+        Matrix *scale = kernel.properties[@"Scale"];
+        int N = inputSize;
+        int D = featureCount;
+        
+        // Box-Muller transform of uniform samples
+        Matrix *u1 = [Matrix uniformRandomRows:D columns:N domain:YCMakeDomain(0, 1)];
+        Matrix *u2 = [Matrix uniformRandomRows:D columns:N domain:YCMakeDomain(0, 1)];
+        Matrix *frequencies = [Matrix matrixOfRows:D columns:N];
+        double sigma = sqrt(2.0) / beta;
+        for (int d=0; d<D; d++)
+        {
+            for (int k=0; k<N; k++)
+            {
+                int i = d * N + k;
+                double g = sqrt(-2.0 * log(1.0 - u1->matrix[i])) * cos(2.0 * M_PI * u2->matrix[i]);
+                frequencies->matrix[i] = g * sigma * (scale ? scale->matrix[k] : 1.0);
+            }
+        }
+        _frequencies = frequencies;
+        _phases = [Matrix uniformRandomRows:D columns:1 domain:YCMakeDomain(0, 2 * M_PI)];
+    }
+    return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super initWithCoder:aDecoder];
+    if (self)
+    {
+        _frequencies = [aDecoder decodeObjectForKey:@"frequencies"];
+        _phases      = [aDecoder decodeObjectForKey:@"phases"];
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [super encodeWithCoder:aCoder];
+    [aCoder encodeObject:_frequencies forKey:@"frequencies"];
+    [aCoder encodeObject:_phases forKey:@"phases"];
+}
+
+- (Matrix *)featuresForMatrix:(Matrix *)matrix
+{
+    NSAssert(matrix->rows == self.inputSize, @"Input size mismatch");
+    int N = self.inputSize;
+    int D = self.featureCount;
+    int S = matrix->columns;
+    Matrix *features = [Matrix matrixOfRows:D columns:S];
+    if (S == 0) return features;
+    
+    // Z = sqrt(2/D) cos(W X + b), with the phases broadcast for GEMM
+    for (int d=0; d<D; d++)
+    {
+        vDSP_vfillD(&_phases->matrix[d], features->matrix + d * S, 1, S);
+    }
+    cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, D, S, N,
+                1.0, _frequencies->matrix, N, matrix->matrix, S, 1.0, features->matrix, S);
+    int count = D * S;
+    vvcos(features->matrix, features->matrix, &count);
+    double factor = sqrt(2.0 / D);
+    vDSP_vsmulD(features->matrix, 1, &factor, features->matrix, 1, count);
+    return features;
+}
+
+- (int)inputSize
+{
+    return _frequencies->columns;
+}
+
+- (int)featureCount
+{
+    return _frequencies->rows;
+}
+
+@end
@@ -0,0 +1,48 @@
+//
+//  YCActivationKernels.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Accelerate;
+
+// In-place activation kernels over contiguous double precision values,
+// shared by the layer classes and by compiled FFN plans
+
+static inline void YCSigmoidActivation(double *values, int count)
+{
+    // 1 / (1 + exp(-x))
+    double one = 1.0;
+    vDSP_vnegD(values, 1, values, 1, count);
+    vvexp(values, values, &count);
+    vDSP_vsaddD(values, 1, &one, values, 1, count);
+    vvrec(values, values, &count);
+}
+
+static inline void YCTanhActivation(double *values, int count)
+{
+    vvtanh(values, values, &count);
+}
+
+static inline void YCReLUActivation(double *values, int count)
+{
+    // max(x, 0)
+    double zero = 0.0;
+    vDSP_vthresD(values, 1, &zero, values, 1, count);
+}
@@ -0,0 +1,84 @@
+//
+//  YCBlockSparseMatrix.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+@class Matrix;
+
+/**
+ An immutable block-sparse matrix (BSR format). The matrix is divided in
+ square blocks of blockSize x blockSize elements (smaller at the edges);
+ only blocks containing at least one non-zero element are stored, each
+ as a contiguous row-major tile, so that products with dense matrices
+ are computed through one small GEMM per stored block.
+ */
+@interface YCBlockSparseMatrix : NSObject <NSCoding>
+
+/**
+ Initializes a block-sparse matrix with the non-zero blocks of |matrix|.
+ 
+ @param matrix    The dense matrix.
+ @param blockSize The size of each block.
+ 
+ @return The block-sparse matrix.
+ */
+- (instancetype)initWithMatrix:(Matrix *)matrix blockSize:(int)blockSize;
+
+/**
+ Returns a dense copy of the receiver.
+ */
+- (Matrix *)denseMatrix;
+
+/**
+ Adds the product of a block row of the receiver with a dense matrix to
+ a dense output, i.e. Z += A[rows of blockRow, :] * X.
+ 
+ @param blockRow     The index of the block row.
+ @param input        Pointer to the dense matrix X (columns x count).
+ @param inputStride  The distance between consecutive rows of X.
+ @param output       Pointer to the first output row of the block row.
+ @param outputStride The distance between consecutive rows of Z.
+ @param count        The number of columns of X and Z.
+ */
+- (void)multiplyBlockRow:(int)blockRow
+                  values:(const double *)input stride:(int)inputStride
+                    into:(double *)output stride:(int)outputStride
+                 columns:(int)count;
+
+@property (readonly) int rows;
+
+@property (readonly) int columns;
+
+@property (readonly) int blockSize;
+
+@property (readonly) int blockRowCount;
+
+/**
+ The number of stored blocks.
+ */
+@property (readonly) int blockCount;
+
+/**
+ The fraction of blocks that are stored.
+ */
+@property (readonly) double density;
+
+@end
@@ -0,0 +1,176 @@
+//
+//  YCBlockSparseMatrix.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCBlockSparseMatrix.h"
+
+@implementation YCBlockSparseMatrix
+{
+    NSData *_rowStarts;     // int, blockRowCount + 1
+    NSData *_blockColumns;  // int, blockCount
+    NSData *_tileOffsets;   // int, blockCount
+    NSData *_tiles;         // double, concatenated tiles
+}
+
+- (instancetype)initWithMatrix:(Matrix *)matrix blockSize:(int)blockSize
+{
+    self = [super init];
+    if (self)
+    {
+        _rows          = matrix->rows;
+        _columns       = matrix->columns;
+        _blockSize     = MAX(1, blockSize);
+        _blockRowCount = (_rows + _blockSize - 1) / _blockSize;
+        int blockColumnCount = (_columns + _blockSize - 1) / _blockSize;
+        
+        NSMutableData *rowStarts = [NSMutableData dataWithLength:(_blockRowCount + 1) * sizeof(int)];
+        NSMutableData *blockColumns = [NSMutableData data];
+        NSMutableData *tileOffsets = [NSMutableData data];
+        NSMutableData *tiles = [NSMutableData data];
+        int *starts = rowStarts.mutableBytes;
+        int count = 0;
+        
+        for (int br=0; br<_blockRowCount; br++)
+        {
+            starts[br] = count;
+            int r0 = br * _blockSize;
+            int tr = MIN(_blockSize, _rows - r0);
+            for (int bc=0; bc<blockColumnCount; bc++)
+            {
+                int c0 = bc * _blockSize;
+                int tc = MIN(_blockSize, _columns - c0);
+                BOOL empty = YES;
+                for (int r=0; r<tr && empty; r++)
+                {
+                    const double *row = matrix->matrix + (r0 + r) * _columns + c0;
+                    for (int c=0; c<tc; c++)
+                    {
+                        if (row[c] != 0) { empty = NO; break; }
+                    }
+                }
+                if (empty) continue;
+                
+                int offset = (int)(tiles.length / sizeof(double));
+                [blockColumns appendBytes:&bc length:sizeof(int)];
+                [tileOffsets appendBytes:&offset length:sizeof(int)];
+                for (int r=0; r<tr; r++)
+                {
+                    [tiles appendBytes:matrix->matrix + (r0 + r) * _columns + c0
+                                length:tc * sizeof(double)];
+                }
+                count++;
+            }
+        }
+        starts[_blockRowCount] = count;
+        
+        _blockCount   = count;
+        _density      = _blockRowCount * blockColumnCount > 0 ?
+        (double)count / (_blockRowCount * blockColumnCount) : 0;
+        _rowStarts    = rowStarts;
+        _blockColumns = blockColumns;
+        _tileOffsets  = tileOffsets;
+        _tiles        = tiles;
+    }
+    return self;
+}
+
+- (Matrix *)denseMatrix
+{
+    Matrix *result = [Matrix matrixOfRows:_rows columns:_columns];
+    const int *starts = _rowStarts.bytes;
+    const int *blockColumns = _blockColumns.bytes;
+    const int *offsets = _tileOffsets.bytes;
+    const double *tiles = _tiles.bytes;
+    for (int br=0; br<_blockRowCount; br++)
+    {
+        int r0 = br * _blockSize;
+        int tr = MIN(_blockSize, _rows - r0);
+        for (int k=starts[br]; k<starts[br+1]; k++)
+        {
+            int c0 = blockColumns[k] * _blockSize;
+            int tc = MIN(_blockSize, _columns - c0);
+            for (int r=0; r<tr; r++)
+            {
+                memcpy(result->matrix + (r0 + r) * _columns + c0, tiles + offsets[k] + r * tc,
+                       tc * sizeof(double));
+            }
+        }
+    }
+    return result;
+}
+
+- (void)multiplyBlockRow:(int)blockRow
+                  values:(const double *)input stride:(int)inputStride
+                    into:(double *)output stride:(int)outputStride
+                 columns:(int)count
+{
+    const int *starts = _rowStarts.bytes;
+    const int *blockColumns = _blockColumns.bytes;
+    const int *offsets = _tileOffsets.bytes;
+    const double *tiles = _tiles.bytes;
+    int tr = MIN(_blockSize, _rows - blockRow * _blockSize);
+    for (int k=starts[blockRow]; k<starts[blockRow+1]; k++)
+    {
+        int c0 = blockColumns[k] * _blockSize;
+        int tc = MIN(_blockSize, _columns - c0);
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, tr, count, tc,
+                    1.0, tiles + offsets[k], tc, input + c0 * inputStride, inputStride,
+                    1.0, output, outputStride);
+    }
+}
+
+#pragma mark - NSCoding Implementation
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+    self = [super init];
+    if (self)
+    {
+        _rows          = [aDecoder decodeIntForKey:@"rows"];
+        _columns       = [aDecoder decodeIntForKey:@"columns"];
+        _blockSize     = [aDecoder decodeIntForKey:@"blockSize"];
+        _blockRowCount = (_rows + _blockSize - 1) / _blockSize;
+        _rowStarts     = [aDecoder decodeObjectForKey:@"rowStarts"];
+        _blockColumns  = [aDecoder decodeObjectForKey:@"blockColumns"];
+        _tileOffsets   = [aDecoder decodeObjectForKey:@"tileOffsets"];
+        _tiles         = [aDecoder decodeObjectForKey:@"tiles"];
+        _blockCount    = (int)(_blockColumns.length / sizeof(int));
+        int blockColumnCount = (_columns + _blockSize - 1) / _blockSize;
+        _density       = _blockRowCount * blockColumnCount > 0 ?
+        (double)_blockCount / (_blockRowCount * blockColumnCount) : 0;
+    }
+    return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+    [aCoder encodeInt:_rows forKey:@"rows"];
+    [aCoder encodeInt:_columns forKey:@"columns"];
+    [aCoder encodeInt:_blockSize forKey:@"blockSize"];
+    [aCoder encodeObject:_rowStarts forKey:@"rowStarts"];
+    [aCoder encodeObject:_blockColumns forKey:@"blockColumns"];
+    [aCoder encodeObject:_tileOffsets forKey:@"tileOffsets"];
+    [aCoder encodeObject:_tiles forKey:@"tiles"];
+}
+
+@end
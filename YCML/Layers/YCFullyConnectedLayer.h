@@ -21,7 +21,7 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 #import "YCModelLayer.h"
-@class Matrix;
+@class Matrix, YCSparseMatrix, YCBlockSparseMatrix;
 
 /**
  A densely connected feed-forward layer. This layer is not directly used 
@@ -34,14 +34,120 @@
 
 - (instancetype)initWithInputSize:(int)inputSize outputSize:(int)outputSize;
 
+/**
+ Propagates |input| through the receiver and returns the result. The
+ returned matrix is also retained as the receiver's lastActivation (no
+ copy is made), so it should not be modified in place by the caller.
+ 
+ @param input The input matrix (IxS).
+ 
+ @return The output matrix (OxS).
+ */
 - (Matrix *)forward:(Matrix *)input;
 
+/**
+ Propagates |input| through the receiver, writing the result to a
+ preallocated |output| matrix. Does not modify lastActivation.
+ 
+ @param input  The input matrix (IxS).
+ @param output The output matrix (OxS).
+ */
+- (void)forward:(Matrix *)input into:(Matrix *)output;
+
+/**
+ Fused forward propagation kernel operating on raw row-major buffers.
+ The bias is broadcast into the output, the weighted input is accumulated
+ on top of it through a single GEMM call, and the activation function is
+ applied while the output tile is still in cache.
+ 
+ @param input        Pointer to the input values (I rows).
+ @param inputStride  The distance between consecutive input rows.
+ @param output       Pointer to the output values (O rows).
+ @param outputStride The distance between consecutive output rows.
+ @param columns      The number of samples (columns) to propagate.
+ */
+- (void)forwardValues:(const double *)input stride:(int)inputStride
+                 into:(double *)output stride:(int)outputStride
+              columns:(int)columns;
+
+/**
+ Sparse counterpart of forward:. The weighted input of each sample is
+ computed as a gather-and-add of the weight rows that correspond to its
+ non-zero input elements. The result is retained as lastActivation.
+ 
+ @param input The sparse input matrix (IxS).
+ 
+ @return The output matrix (OxS).
+ */
+- (Matrix *)forwardSparse:(YCSparseMatrix *)input;
+
+/**
+ Sparse counterpart of forward:into:. Does not modify lastActivation.
+ 
+ @param input  The sparse input matrix (IxS).
+ @param output The output matrix (OxS).
+ */
+- (void)forwardSparse:(YCSparseMatrix *)input into:(Matrix *)output;
+
+/**
+ As forwardSparse:into:, using |bias| in place of the receiver's bias
+ vector, e.g. to account for an input offset folded into the bias.
+ */
+- (void)forwardSparse:(YCSparseMatrix *)input bias:(Matrix *)bias into:(Matrix *)output;
+
+/**
+ Adds the weight gradients X * D' of a batch of sparse input columns to
+ |gradients|, touching only the weight rows that correspond to non-zero
+ input elements.
+ 
+ @param gradients The weight gradients to accumulate into (IxO).
+ @param input     The sparse input matrix (IxS).
+ @param range     The range of input columns making up the batch.
+ @param deltas    The output deltas of the batch (O x range.length).
+ */
+- (void)accumulateWeightGradients:(Matrix *)gradients
+                      sparseInput:(YCSparseMatrix *)input
+                          columns:(NSRange)range
+                           deltas:(Matrix *)deltas;
+
 - (void)activationFunction:(Matrix *)inputCopy;
 
+/**
+ Applies the activation function in place to |count| contiguous values.
+ The default implementation wraps the values in a matrix and calls
+ activationFunction:. Subclasses override it with a vectorized version.
+ */
+- (void)activationFunctionOnValues:(double *)values count:(int)count;
+
 - (void)activationFunctionGradient:(Matrix *)outputCopy;
 
+/**
+ Single precision counterparts of activationFunctionOnValues: and
+ activationFunctionGradient:, used by mixed-precision training. The
+ gradient is computed in place from the activated outputs. The default
+ implementations convert to double precision and back.
+ */
+- (void)activationFunctionOnFloatValues:(float *)values count:(int)count;
+
+- (void)activationFunctionGradientOnFloatValues:(float *)values count:(int)count;
+
 - (double)regularizationLoss;
 
+/**
+ Stores the transposed weights of the receiver in block-sparse form, if
+ the fraction of non-zero blocks does not exceed |maximumDensity|. When a
+ compressed form exists, forward propagation multiplies only the stored
+ blocks, and archiving stores it in place of the dense weights. Assigning
+ a new weight matrix discards the compressed form; in-place modifications
+ of the weights require compressing again.
+ 
+ @param blockSize      The size of the square weight blocks.
+ @param maximumDensity The maximum fraction of non-zero blocks.
+ 
+ @return YES if the weights were compressed, NO otherwise.
+ */
+- (BOOL)compressWeightsWithBlockSize:(int)blockSize maximumDensity:(double)maximumDensity;
+
 /**
  Returns the weight matrix of the receiver.
  */
@@ -52,6 +158,12 @@
  */
 @property Matrix *biasVector;
 
+/**
+ Returns the block-sparse form of the transposed weights (OxI) of the
+ receiver, or nil if the weights have not been compressed.
+ */
+@property (readonly) YCBlockSparseMatrix *sparseWeightMatrix;
+
 @property Matrix *lastActivation;
 
 @property double L2;
@@ -21,14 +21,23 @@
 // along with YCML.  If not, see <http://www.gnu.org/licenses/>.
 
 #import "YCFullyConnectedLayer.h"
+#import "YCSparseMatrix.h"
+#import "YCBlockSparseMatrix.h"
 @import YCMatrix;
+@import Accelerate;
 
 // I: Input size
 // O: Output size
 // S: Sample count
 
+// Target number of output elements per tile, so that each tile stays in cache
+// between the GEMM and the activation pass
+#define TILE_ELEMENTS 8192
+
 @implementation YCFullyConnectedLayer
 
+@synthesize weightMatrix = _weightMatrix;
+
 + (instancetype)layerWithInputSize:(int)inputSize outputSize:(int)outputSize
 {
     return [[self alloc] initWithInputSize:inputSize outputSize:outputSize];
@@ -47,15 +56,176 @@
     return self;
 }
 
+- (Matrix *)weightMatrix
+{
+    return _weightMatrix;
+}
+
+- (void)setWeightMatrix:(Matrix *)weightMatrix
+{
+    _weightMatrix = weightMatrix;
+    _sparseWeightMatrix = nil;
+}
+
+- (BOOL)compressWeightsWithBlockSize:(int)blockSize maximumDensity:(double)maximumDensity
+{
+    YCBlockSparseMatrix *sparse =
+    [[YCBlockSparseMatrix alloc] initWithMatrix:[self.weightMatrix matrixByTransposing]
+                                      blockSize:blockSize];
+    if (sparse.density > maximumDensity) return NO;
+    _sparseWeightMatrix = sparse;
+    return YES;
+}
+
 - (Matrix *)forward:(Matrix *)input
 {
-    Matrix *output = [self.weightMatrix matrixByTransposingAndMultiplyingWithRight:input]; // (IxO)T * IxS = OxS
-    [output addColumn:self.biasVector];
-    [self activationFunction:output];
-    self.lastActivation = [output copy];
+    Matrix *output = [Matrix matrixOfRows:self.outputSize columns:input.columns];
+    [self forward:input into:output];
+    self.lastActivation = output;
     return output;
 }
 
+- (void)forward:(Matrix *)input into:(Matrix *)output
+{
+    NSAssert(input->rows == self.inputSize, @"Input size mismatch");
+    NSAssert(output->rows == self.outputSize && output->columns == input->columns,
+             @"Output size mismatch");
+    [self forwardValues:input->matrix stride:input->columns
+                   into:output->matrix stride:output->columns
+                columns:input->columns];
+}
+
+- (void)forwardValues:(const double *)input stride:(int)inputStride
+                 into:(double *)output stride:(int)outputStride
+              columns:(int)columns
+{
+    int I = self.weightMatrix->rows;
+    int O = self.weightMatrix->columns;
+    int S = columns;
+    if (S == 0) return;
+    double *weights = self.weightMatrix->matrix;
+    double *bias = self.biasVector->matrix;
+    
+    YCBlockSparseMatrix *sparse = _sparseWeightMatrix;
+    if (sparse)
+    {
+        // One block row of the transposed weights per tile
+        int blockSize = sparse.blockSize;
+        for (int br=0; br<sparse.blockRowCount; br++)
+        {
+            int r0 = br * blockSize;
+            int tr = MIN(blockSize, O - r0);
+            double *tile = output + r0 * outputStride;
+            for (int r=0; r<tr; r++)
+            {
+                vDSP_vfillD(&bias[r0 + r], tile + r * outputStride, 1, S);
+            }
+            [sparse multiplyBlockRow:br values:input stride:inputStride
+                                into:tile stride:outputStride columns:S];
+            for (int r=0; r<tr; r++)
+            {
+                [self activationFunctionOnValues:tile + r * outputStride count:S];
+            }
+        }
+        return;
+    }
+    
+    int tileRows = MAX(1, MIN(O, TILE_ELEMENTS / S));
+    
+    for (int r0=0; r0<O; r0+=tileRows)
+    {
+        int tr = MIN(tileRows, O - r0);
+        double *tile = output + r0 * outputStride;
+        
+        // Broadcast the bias, so that it is picked up by GEMM through beta = 1
+        for (int r=0; r<tr; r++)
+        {
+            vDSP_vfillD(&bias[r0 + r], tile + r * outputStride, 1, S);
+        }
+        
+        // (IxO)T[r0:r0+tr] * IxS + B = trxS
+        cblas_dgemm(CblasRowMajor, CblasTrans, CblasNoTrans, tr, S, I,
+                    1.0, weights + r0, O, input, inputStride,
+                    1.0, tile, outputStride);
+        
+        // Activation, while the tile is hot
+        if (outputStride == S)
+        {
+            [self activationFunctionOnValues:tile count:tr * S];
+        }
+        else
+        {
+            for (int r=0; r<tr; r++)
+            {
+                [self activationFunctionOnValues:tile + r * outputStride count:S];
+            }
+        }
+    }
+}
+
+- (Matrix *)forwardSparse:(YCSparseMatrix *)input
+{
+    Matrix *output = [Matrix matrixOfRows:self.outputSize columns:input.columns];
+    [self forwardSparse:input into:output];
+    self.lastActivation = output;
+    return output;
+}
+
+- (void)forwardSparse:(YCSparseMatrix *)input into:(Matrix *)output
+{
+    [self forwardSparse:input bias:self.biasVector into:output];
+}
+
+- (void)forwardSparse:(YCSparseMatrix *)input bias:(Matrix *)biasVector into:(Matrix *)output
+{
+    NSAssert(input.rows == self.inputSize, @"Input size mismatch");
+    int O = self.outputSize;
+    int S = input.columns;
+    const double *weights = self.weightMatrix->matrix;
+    const double *bias    = biasVector->matrix;
+    const int *starts     = input.columnStarts;
+    const int *indexes    = input.rowIndexes;
+    const double *values  = input.values;
+    
+    // Accumulate sample-major, so that each sample is contiguous, then transpose
+    double *samples = malloc(S * O * sizeof(double));
+    for (int j=0; j<S; j++)
+    {
+        double *z = samples + j * O;
+        cblas_dcopy(O, bias, 1, z, 1);
+        for (int k=starts[j]; k<starts[j+1]; k++)
+        {
+            cblas_daxpy(O, values[k], weights + indexes[k] * O, 1, z, 1);
+        }
+    }
+    vDSP_mtransD(samples, 1, output->matrix, 1, O, S);
+    free(samples);
+    
+    [self activationFunctionOnValues:output->matrix count:O * S];
+}
+
+- (void)accumulateWeightGradients:(Matrix *)gradients
+                      sparseInput:(YCSparseMatrix *)input
+                          columns:(NSRange)range
+                           deltas:(Matrix *)deltas
+{
+    int O = self.outputSize;
+    int n = (int)range.length;
+    const int *starts    = input.columnStarts;
+    const int *indexes   = input.rowIndexes;
+    const double *values = input.values;
+    double *g = gradients->matrix;
+    
+    for (int c=0; c<n; c++)
+    {
+        int j = (int)range.location + c;
+        for (int k=starts[j]; k<starts[j+1]; k++)
+        {
+            cblas_daxpy(O, values[k], deltas->matrix + c, n, g + indexes[k] * O, 1);
+        }
+    }
+}
+
 - (Matrix *)backward:(Matrix *)outputDeltas input:(Matrix *)input
 {
     @throw [NSInternalInconsistencyException initWithFormat:
@@ -79,12 +249,33 @@
             @"You must override %@ in subclass %@", NSStringFromSelector(_cmd), [self class]];
 }
 
+- (void)activationFunctionOnValues:(double *)values count:(int)count
+{
+    [self activationFunction:[Matrix matrixFromArray:values rows:1 columns:count mode:YCMWeak]];
+}
+
 - (void)activationFunctionGradient:(Matrix *)outputCopy
 {
     @throw [NSInternalInconsistencyException initWithFormat:
             @"You must override %@ in subclass %@", NSStringFromSelector(_cmd), [self class]];
 }
 
+- (void)activationFunctionOnFloatValues:(float *)values count:(int)count
+{
+    Matrix *converted = [Matrix matrixOfRows:1 columns:count];
+    vDSP_vspdp(values, 1, converted->matrix, 1, count);
+    [self activationFunctionOnValues:converted->matrix count:count];
+    vDSP_vdpsp(converted->matrix, 1, values, 1, count);
+}
+
+- (void)activationFunctionGradientOnFloatValues:(float *)values count:(int)count
+{
+    Matrix *converted = [Matrix matrixOfRows:1 columns:count];
+    vDSP_vspdp(values, 1, converted->matrix, 1, count);
+    [self activationFunctionGradient:converted];
+    vDSP_vdpsp(converted->matrix, 1, values, 1, count);
+}
+
 - (int)inputSize
 {
     return self.weightMatrix.rows;
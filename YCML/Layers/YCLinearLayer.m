@@ -22,6 +22,7 @@
 
 #import "YCLinearLayer.h"
 @import YCMatrix;
+@import Accelerate;
 
 @implementation YCLinearLayer
 
@@ -30,6 +31,11 @@
     // Do nothing y = x
 }
 
+- (void)activationFunctionOnValues:(double *)values count:(int)count
+{
+    // Do nothing y = x
+}
+
 - (void)activationFunctionGradient:(Matrix *)outputCopy
 {
     [outputCopy applyFunction:^double(double value) {
@@ -37,4 +43,15 @@
     }];
 }
 
+- (void)activationFunctionOnFloatValues:(float *)values count:(int)count
+{
+    // Do nothing y = x
+}
+
+- (void)activationFunctionGradientOnFloatValues:(float *)values count:(int)count
+{
+    float one = 1.0f;
+    vDSP_vfill(&one, values, 1, count);
+}
+
 @end
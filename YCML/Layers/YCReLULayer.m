@@ -22,18 +22,19 @@
 
 #import "YCReLULayer.h"
 @import YCMatrix;
+@import Accelerate;
+#import "YCActivationKernels.h"
 
 @implementation YCReLULayer
 
 - (void)activationFunction:(Matrix *)inputCopy
 {
-    [inputCopy applyFunction:^double(double value) {
-        if (value < 0)
-        {
-            return 0.0;
-        }
-        return value;
-    }];
+    [self activationFunctionOnValues:inputCopy->matrix count:inputCopy->rows * inputCopy->columns];
+}
+
+- (void)activationFunctionOnValues:(double *)values count:(int)count
+{
+    YCReLUActivation(values, count);
 }
 
 - (void)activationFunctionGradient:(Matrix *)outputCopy
@@ -47,4 +48,18 @@
     }];
 }
 
+- (void)activationFunctionOnFloatValues:(float *)values count:(int)count
+{
+    float zero = 0.0f;
+    vDSP_vthres(values, 1, &zero, values, 1, count);
+}
+
+- (void)activationFunctionGradientOnFloatValues:(float *)values count:(int)count
+{
+    for (int i=0; i<count; i++)
+    {
+        values[i] = values[i] == 0 ? 0.0f : 1.0f;
+    }
+}
+
 @end
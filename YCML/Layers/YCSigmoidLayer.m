@@ -22,14 +22,19 @@
 
 #import "YCSigmoidLayer.h"
 @import YCMatrix;
+@import Accelerate;
+#import "YCActivationKernels.h"
 
 @implementation YCSigmoidLayer
 
 - (void)activationFunction:(Matrix *)inputCopy
 {
-    [inputCopy applyFunction:^double(double value) {
-        return 1.0 / (1.0 + exp(-value));
-    }];
+    [self activationFunctionOnValues:inputCopy->matrix count:inputCopy->rows * inputCopy->columns];
+}
+
+- (void)activationFunctionOnValues:(double *)values count:(int)count
+{
+    YCSigmoidActivation(values, count);
 }
 
 - (void)activationFunctionGradient:(Matrix *)outputCopy
@@ -39,4 +44,23 @@
     }];
 }
 
+- (void)activationFunctionOnFloatValues:(float *)values count:(int)count
+{
+    // 1 / (1 + exp(-x))
+    float one = 1.0f;
+    vDSP_vneg(values, 1, values, 1, count);
+    vvexpf(values, values, &count);
+    vDSP_vsadd(values, 1, &one, values, 1, count);
+    vvrecf(values, values, &count);
+}
+
+- (void)activationFunctionGradientOnFloatValues:(float *)values count:(int)count
+{
+    // y * (1 - y) = y - y^2
+    for (int i=0; i<count; i++)
+    {
+        values[i] = values[i] * (1.0f - values[i]);
+    }
+}
+
 @end
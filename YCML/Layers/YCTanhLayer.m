@@ -22,14 +22,19 @@
 
 #import "YCTanhLayer.h"
 @import YCMatrix;
+@import Accelerate;
+#import "YCActivationKernels.h"
 
 @implementation YCTanhLayer
 
 - (void)activationFunction:(Matrix *)inputCopy
 {
-    [inputCopy applyFunction:^double(double value) {
-        return tanh(value);
-    }];
+    [self activationFunctionOnValues:inputCopy->matrix count:inputCopy->rows * inputCopy->columns];
+}
+
+- (void)activationFunctionOnValues:(double *)values count:(int)count
+{
+    YCTanhActivation(values, count);
 }
 
 - (void)activationFunctionGradient:(Matrix *)outputCopy
@@ -39,4 +44,18 @@
     }];
 }
 
+- (void)activationFunctionOnFloatValues:(float *)values count:(int)count
+{
+    vvtanhf(values, values, &count);
+}
+
+- (void)activationFunctionGradientOnFloatValues:(float *)values count:(int)count
+{
+    // 1 - y^2
+    for (int i=0; i<count; i++)
+    {
+        values[i] = 1.0f - values[i] * values[i];
+    }
+}
+
 @end
@@ -7,6 +7,7 @@
 //
 
 #import "YCLinRegModel.h"
+@import Accelerate;
 
 @implementation YCLinRegModel
 
@@ -38,6 +39,44 @@
     return output;
 }
 
+- (void)foldTransforms
+{
+    if (!self.theta) return;
+    
+    // Theta: (N+1)xO, last row holds the bias
+    Matrix *theta = [Matrix matrixFromMatrix:self.theta];
+    int N = theta->rows - 1;
+    int O = theta->columns;
+    double *bias = theta->matrix + N * O;
+    
+    // Input: x' = a.*x + b => bias += theta' * b, theta = diag(a) * theta
+    if (self.inputTransform)
+    {
+        double *transform = self.inputTransform->matrix;
+        for (int i=0; i<N; i++)
+        {
+            double *row = theta->matrix + i * O;
+            vDSP_vsmaD(row, 1, &transform[2*i + 1], bias, 1, bias, 1, O);
+            vDSP_vsmulD(row, 1, &transform[2*i], row, 1, O);
+        }
+        self.inputTransform = nil;
+    }
+    
+    // Output: y' = c.*y + d => theta = theta * diag(c), bias += d
+    if (self.outputTransform)
+    {
+        double *transform = self.outputTransform->matrix;
+        for (int j=0; j<O; j++)
+        {
+            vDSP_vsmulD(theta->matrix + j, O, &transform[2*j], theta->matrix + j, O, N + 1);
+            bias[j] += transform[2*j + 1];
+        }
+        self.outputTransform = nil;
+    }
+    
+    self.theta = theta;
+}
+
 - (int)inputSize
 {
     return self.theta.rows - 1;
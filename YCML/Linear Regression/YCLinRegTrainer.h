@@ -10,4 +10,6 @@
 
 @interface YCLinRegTrainer : YCSupervisedTrainer
 
++ (Class)optimizerClass;
+
 @end
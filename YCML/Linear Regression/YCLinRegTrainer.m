@@ -17,6 +17,11 @@
     return [YCLinRegModel class];
 }
 
++ (Class)optimizerClass
+{
+    return [YCGradientDescent class];
+}
+
 - (instancetype)init
 {
     if (self = [super init])
@@ -50,7 +55,7 @@
                                                                           model:model];
     
     p.l2                              = [self.settings[@"L2"] doubleValue];
-    YCGradientDescent *optimizer      = [[YCGradientDescent alloc] initWithProblem:p];
+    YCOptimizer *optimizer            = [[[[self class] optimizerClass] alloc] initWithProblem:p];
     [optimizer.settings addEntriesFromDictionary:self.settings];
     if ([self.settings[@"Target"] doubleValue] <= 0)
     {
@@ -73,8 +73,8 @@
     // calculate regularization term
     int n = self->_outputMatrix->columns;
     int s = self->_outputMatrix->rows;
-    // Ignore bias (last element)
-    Matrix *weights = [parameters matrixWithRowsInRange:NSMakeRange(0, [self weightParameterCount] - 1)];
+    // Ignore biases (last row of theta)
+    Matrix *weights = [parameters matrixWithRowsInRange:NSMakeRange(0, [self weightParameterCount])];
     [weights square];
     double ws2 = [weights sum];
     
@@ -85,23 +85,26 @@
 
 - (void)derivatives:(Matrix *)target parameters:(Matrix *)parameters
 {
+    // Exact gradient of the cost in -evaluate:parameters:, so that
+    // line-search based optimizers see a consistent objective
     int n                   = self->_outputMatrix->columns;
+    int s                   = self->_outputMatrix->rows;
     self.model.theta = [self thetaWithParameters:parameters];
     Matrix *residual      = [self.model activateWithMatrix:self->_inputMatrix];
     
     // calculate derivative
     [residual subtract:self->_outputMatrix];
     Matrix *gradients = [residual matrixByTransposingAndMultiplyingWithLeft:self->_inputMatrix];
-    [gradients multiplyWithScalar:1.0/n];
+    [gradients multiplyWithScalar:1.0/(n * s)];
     
     // add regularization term
-    Matrix *scaledWeights = [self.model.theta matrixByMultiplyingWithScalar:self.l2];
+    Matrix *scaledWeights = [self.model.theta matrixByMultiplyingWithScalar:2.0 * self.l2];
     scaledWeights = [scaledWeights removeRow:scaledWeights.rows - 1];
     [scaledWeights multiplyWithScalar:1.0/n];
     
     [gradients add:scaledWeights];
     Matrix *biases = [[residual meansOfRows] matrixByTransposing];
-    [biases multiplyWithScalar:1.0/n];
+    [biases multiplyWithScalar:1.0/s];
     gradients = [gradients appendRow:biases];
     
     [target copyValuesFrom:gradients];
@@ -0,0 +1,46 @@
+//
+//  YCLBFGS.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+#import "YCOptimizer.h"
+
+/**
+ Limited-memory BFGS optimizer for smooth, full-batch derivative problems
+ (i.e. problems conforming to YCDerivativeProblem). Each iteration computes
+ a quasi-Newton direction from the most recent curvature pairs, which are
+ kept in preallocated ring buffers, and takes a step satisfying the strong
+ Wolfe conditions. The line search uses both -evaluate:parameters: and
+ -derivatives:parameters: of the problem, so the two should be consistent.
+ Problems that sample their data (e.g. YCBackPropProblem with a positive
+ sampleCount) should be used in full-batch mode. Contrastive divergence
+ problems (YCCDProblem) are not supported: their derivatives are
+ stochastic estimates that are not the gradient of any evaluated cost.
+ 
+ Settings:
+ "Memory"                 : Number of curvature pairs kept.
+ "Tolerance"              : Stops when the largest gradient component falls below it.
+ "Line Search Iterations" : Maximum number of function evaluations per line search.
+ "c1", "c2"               : Sufficient decrease and curvature constants.
+ */
+@interface YCLBFGS : YCOptimizer
+
+@end
@@ -0,0 +1,378 @@
+//
+//  YCLBFGS.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCLBFGS.h"
+#import "YCDerivativeProblem.h"
+
+// k: Number of parameters
+// m: Number of curvature pairs kept in memory
+
+@implementation YCLBFGS
+{
+    int _k;
+    int _m;
+    double _sign;        // +1 for minimization, -1 for maximization
+    double *_x;          // Current values (k)
+    double *_g;          // Current gradients (k)
+    double *_d;          // Search direction (k)
+    double *_s;          // Ring buffer of value differences (m x k)
+    double *_y;          // Ring buffer of gradient differences (m x k)
+    double *_rho;        // 1 / (s'y) for each pair (m)
+    double *_alpha;      // Two-loop recursion coefficients (m)
+    int _head;           // Index of the next slot to write
+    int _pairs;          // Number of valid pairs
+    double _f;           // Current objective value
+    Matrix *_trialValues;
+    Matrix *_trialGradients;
+    Matrix *_objective;
+}
+
+- (instancetype)initWithProblem:(NSObject<YCProblem> *)aProblem settings:(NSDictionary *)settings
+{
+    self = [super initWithProblem:aProblem settings:settings];
+    if (self)
+    {
+        self.settings[@"Memory"]                 = @10;
+        self.settings[@"Tolerance"]              = @1E-6;
+        self.settings[@"Line Search Iterations"] = @20;
+        self.settings[@"c1"]                     = @1E-4;
+        self.settings[@"c2"]                     = @0.9;
+        self.settings[@"Iterations"]             = @100;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self freeBuffers];
+}
+
+- (void)freeBuffers
+{
+    free(_s);
+    free(_y);
+    free(_rho);
+    free(_alpha);
+    free(_d);
+    _s = _y = _rho = _alpha = _d = NULL;
+}
+
+- (void)reset
+{
+    [super reset];
+    [self freeBuffers];
+}
+
+- (BOOL)iterate:(int)iteration
+{
+    if (!_d)
+    {
+        [self initialize];
+    }
+    else if (![self step])
+    {
+        return NO;
+    }
+    
+    double tolerance = [self.settings[@"Tolerance"] doubleValue];
+    if (fabs(_g[cblas_idamax(_k, _g, 1)]) <= tolerance) return NO;
+    
+    if (self.settings[@"Target"])
+    {
+        double target = [self.settings[@"Target"] doubleValue];
+        double best = _sign * _f;
+        if (_sign < 0 ? best >= target : best <= target) return NO;
+    }
+    return YES;
+}
+
+- (void)initialize
+{
+    _k = self.problem.parameterCount;
+    _m = MAX(1, [self.settings[@"Memory"] intValue]);
+    _sign = [self.problem.modes i:0 j:0] > 0 ? -1.0 : 1.0;
+    
+    // Existing values (e.g. from a previous run) are used as a warm start
+    Matrix *values = self.state[@"values"];
+    if (!values || values.count != (NSUInteger)_k)
+    {
+        values = [Matrix matrixOfRows:_k columns:1];
+        Matrix *initialRanges = [self.problem initialValuesRangeHint];
+        for (int i=0; i<_k; i++)
+        {
+            double start = [initialRanges valueAtRow:i column:0];
+            double range = [initialRanges valueAtRow:i column:1] - start;
+            [values setValue:((double)arc4random() / 0x100000000) * range + start
+                         row:i column:0];
+        }
+    }
+    else
+    {
+        values = [values copy];
+    }
+    Matrix *gradients = [Matrix matrixOfRows:_k columns:1];
+    self.state[@"values"]    = values;
+    self.state[@"gradients"] = gradients;
+    self.state[@"evaluations"] = @0;
+    
+    [self freeBuffers];
+    _s     = calloc(_m * _k, sizeof(double));
+    _y     = calloc(_m * _k, sizeof(double));
+    _rho   = calloc(_m, sizeof(double));
+    _alpha = calloc(_m, sizeof(double));
+    _d     = calloc(_k, sizeof(double));
+    _head  = 0;
+    _pairs = 0;
+    
+    _trialValues    = [Matrix matrixOfRows:_k columns:1];
+    _trialGradients = [Matrix matrixOfRows:_k columns:1];
+    _objective      = [Matrix matrixOfRows:self.problem.objectiveCount columns:1];
+    
+    _x = values->matrix;
+    _g = gradients->matrix;
+    _f = [self evaluate:values gradients:gradients];
+    self.state[@"best"] = @(_sign * _f);
+}
+
+- (BOOL)step
+{
+    // 1. Direction, through the two-loop recursion
+    [self computeDirection];
+    double dg0 = cblas_ddot(_k, _g, 1, _d, 1);
+    if (dg0 >= 0)
+    {
+        // Not a descent direction; discard curvature information
+        _pairs = 0;
+        [self computeDirection];
+        dg0 = cblas_ddot(_k, _g, 1, _d, 1);
+        if (dg0 >= 0) return NO;
+    }
+    
+    // 2. Line search, with unit initial step once curvature is known
+    double initialStep = _pairs ? 1.0 : 1.0 / MAX(1.0, cblas_dnrm2(_k, _g, 1));
+    double fNew;
+    double a = [self lineSearchWithSlope:dg0 initialStep:initialStep value:&fNew];
+    if (a <= 0)
+    {
+        if (_pairs == 0) return NO; // Steepest descent failed too
+        _pairs = 0;
+        return YES;
+    }
+    
+    // 3. Store curvature pair: s = x+ - x, y = g+ - g
+    double *s = _s + _head * _k;
+    double *y = _y + _head * _k;
+    vDSP_vsubD(_x, 1, _trialValues->matrix, 1, s, 1, _k);
+    vDSP_vsubD(_g, 1, _trialGradients->matrix, 1, y, 1, _k);
+    double sy = cblas_ddot(_k, s, 1, y, 1);
+    if (sy > 1E-12 * cblas_dnrm2(_k, s, 1) * cblas_dnrm2(_k, y, 1))
+    {
+        _rho[_head] = 1.0 / sy;
+        _head = (_head + 1) % _m;
+        _pairs = MIN(_pairs + 1, _m);
+    }
+    
+    // 4. Accept step
+    cblas_dcopy(_k, _trialValues->matrix, 1, _x, 1);
+    cblas_dcopy(_k, _trialGradients->matrix, 1, _g, 1);
+    _f = fNew;
+    self.state[@"best"] = @(_sign * _f);
+    return YES;
+}
+
+- (void)computeDirection
+{
+    // q = g
+    cblas_dcopy(_k, _g, 1, _d, 1);
+    
+    // Newest to oldest: a_i = rho_i s_i'q, q = q - a_i y_i
+    for (int n=0; n<_pairs; n++)
+    {
+        int i = (_head - 1 - n + _m) % _m;
+        _alpha[i] = _rho[i] * cblas_ddot(_k, _s + i * _k, 1, _d, 1);
+        cblas_daxpy(_k, -_alpha[i], _y + i * _k, 1, _d, 1);
+    }
+    
+    // Initial Hessian approximation: gamma = s'y / y'y of the newest pair
+    if (_pairs)
+    {
+        int i = (_head - 1 + _m) % _m;
+        double *y = _y + i * _k;
+        cblas_dscal(_k, 1.0 / (_rho[i] * cblas_ddot(_k, y, 1, y, 1)), _d, 1);
+    }
+    
+    // Oldest to newest: b = rho_i y_i'r, r = r + s_i (a_i - b)
+    for (int n=_pairs-1; n>=0; n--)
+    {
+        int i = (_head - 1 - n + _m) % _m;
+        double b = _rho[i] * cblas_ddot(_k, _y + i * _k, 1, _d, 1);
+        cblas_daxpy(_k, _alpha[i] - b, _s + i * _k, 1, _d, 1);
+    }
+    
+    // d = -r
+    vDSP_vnegD(_d, 1, _d, 1, _k);
+}
+
+#pragma mark - Line Search
+
+// Strong Wolfe line search (Nocedal & Wright, Algorithms 3.5 & 3.6).
+// On success, leaves the accepted point in the trial buffers and returns
+// the step length. Returns 0 on failure.
+- (double)lineSearchWithSlope:(double)dg0 initialStep:(double)initialStep value:(double *)value
+{
+    int maxEvaluations = [self.settings[@"Line Search Iterations"] intValue];
+    double c1 = [self.settings[@"c1"] doubleValue];
+    double c2 = [self.settings[@"c2"] doubleValue];
+    double f0 = _f;
+    
+    double aPrev = 0, fPrev = f0, dgPrev = dg0;
+    double a = initialStep;
+    
+    for (int i=0; i<maxEvaluations; i++)
+    {
+        double dg;
+        double f = [self phi:a slope:&dg];
+        
+        if (!isfinite(f) || f > f0 + c1 * a * dg0 || (i > 0 && f >= fPrev))
+        {
+            return [self zoomLow:aPrev value:fPrev slope:dgPrev
+                            high:a value:f slope:dg
+                              f0:f0 dg0:dg0 c1:c1 c2:c2
+                  maxEvaluations:maxEvaluations - i - 1 result:value];
+        }
+        if (fabs(dg) <= -c2 * dg0)
+        {
+            *value = f;
+            return a;
+        }
+        if (dg >= 0)
+        {
+            return [self zoomLow:a value:f slope:dg
+                            high:aPrev value:fPrev slope:dgPrev
+                              f0:f0 dg0:dg0 c1:c1 c2:c2
+                  maxEvaluations:maxEvaluations - i - 1 result:value];
+        }
+        aPrev = a; fPrev = f; dgPrev = dg;
+        a *= 2.0;
+    }
+    return 0;
+}
+
+- (double)zoomLow:(double)lo value:(double)flo slope:(double)dglo
+             high:(double)hi value:(double)fhi slope:(double)dghi
+               f0:(double)f0 dg0:(double)dg0 c1:(double)c1 c2:(double)c2
+   maxEvaluations:(int)maxEvaluations result:(double *)value
+{
+    for (int j=0; j<maxEvaluations; j++)
+    {
+        // Safeguarded cubic interpolation, falling back to bisection
+        double a = 0.5 * (lo + hi);
+        if (isfinite(fhi))
+        {
+            double d1 = dglo + dghi - 3.0 * (flo - fhi) / (lo - hi);
+            double r = d1 * d1 - dglo * dghi;
+            if (r >= 0)
+            {
+                double d2 = (hi > lo ? 1.0 : -1.0) * sqrt(r);
+                double c = hi - (hi - lo) * (dghi + d2 - d1) / (dghi - dglo + 2.0 * d2);
+                double margin = 0.1 * fabs(hi - lo);
+                if (isfinite(c) && c > MIN(lo, hi) + margin && c < MAX(lo, hi) - margin) a = c;
+            }
+        }
+        
+        double dg;
+        double f = [self phi:a slope:&dg];
+        
+        if (!isfinite(f) || f > f0 + c1 * a * dg0 || f >= flo)
+        {
+            hi = a; fhi = f; dghi = dg;
+        }
+        else
+        {
+            if (fabs(dg) <= -c2 * dg0)
+            {
+                *value = f;
+                return a;
+            }
+            if (dg * (hi - lo) >= 0)
+            {
+                hi = lo; fhi = flo; dghi = dglo;
+            }
+            lo = a; flo = f; dglo = dg;
+        }
+    }
+    
+    // Fall back to the best point found, which satisfies sufficient decrease
+    if (lo > 0)
+    {
+        double dg;
+        *value = [self phi:lo slope:&dg];
+        return lo;
+    }
+    return 0;
+}
+
+// Evaluates the objective and its directional derivative at x + a*d,
+// leaving the point and its gradient in the trial buffers.
+- (double)phi:(double)a slope:(double *)slope
+{
+    cblas_dcopy(_k, _x, 1, _trialValues->matrix, 1);
+    cblas_daxpy(_k, a, _d, 1, _trialValues->matrix, 1);
+    double f = [self evaluate:_trialValues gradients:_trialGradients];
+    *slope = cblas_ddot(_k, _trialGradients->matrix, 1, _d, 1);
+    return f;
+}
+
+- (double)evaluate:(Matrix *)values gradients:(Matrix *)gradients
+{
+    [self.problem evaluate:_objective parameters:values];
+    [(NSObject<YCDerivativeProblem> *)self.problem derivatives:gradients parameters:values];
+    self.state[@"evaluations"] = @([self.state[@"evaluations"] intValue] + 1);
+    if (_sign < 0)
+    {
+        vDSP_vnegD(gradients->matrix, 1, gradients->matrix, 1, _k);
+    }
+    return _sign * [_objective sum];
+}
+
+#pragma mark - Results
+
+- (NSArray *)bestParameters
+{
+    if (!self.state[@"values"]) return nil;
+    return @[self.state[@"values"]];
+}
+
+- (NSArray *)bestObjectives
+{
+    if (!self.state[@"best"]) return nil;
+    return @[self.state[@"best"]];
+}
+
+- (NSArray *)bestConstraints
+{
+    return @[@0];
+}
+
+@end
@@ -0,0 +1,37 @@
+//
+//  YCAdam.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+#import "YCStochasticOptimizer.h"
+
+/**
+ Adam stochastic optimizer (Kingma & Ba, 2015).
+ 
+ Settings:
+ "Beta1"        : Exponential decay rate of the first moment estimates.
+ "Beta2"        : Exponential decay rate of the second moment estimates.
+ "Epsilon"      : Term added to the denominator for numerical stability.
+ "Weight Decay" : Decoupled weight decay coefficient (see YCAdamW).
+ */
+@interface YCAdam : YCStochasticOptimizer
+
+@end
@@ -0,0 +1,91 @@
+//
+//  YCAdam.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCAdam.h"
+
+@implementation YCAdam
+
+- (instancetype)initWithProblem:(NSObject<YCProblem> *)aProblem settings:(NSDictionary *)settings
+{
+    self = [super initWithProblem:aProblem settings:settings];
+    if (self)
+    {
+        self.settings[@"Learning Rate"] = @0.001;
+        self.settings[@"Beta1"]         = @0.9;
+        self.settings[@"Beta2"]         = @0.999;
+        self.settings[@"Epsilon"]       = @1E-8;
+        self.settings[@"Weight Decay"]  = @0;
+    }
+    return self;
+}
+
+- (void)prepareStateWithParameterCount:(int)count
+{
+    self.state[@"firstMoments"]  = [Matrix matrixOfRows:count columns:1];
+    self.state[@"secondMoments"] = [Matrix matrixOfRows:count columns:1];
+    self.state[@"scratch"]       = [Matrix matrixOfRows:count columns:1];
+}
+
+- (void)updateValues:(Matrix *)values gradients:(Matrix *)gradients rate:(double)rate step:(int)step
+{
+    int k              = (int)values.count;
+    double beta1       = [self.settings[@"Beta1"] doubleValue];
+    double beta2       = [self.settings[@"Beta2"] doubleValue];
+    double epsilon     = [self.settings[@"Epsilon"] doubleValue];
+    double weightDecay = [self.settings[@"Weight Decay"] doubleValue];
+    double oneMinusB1  = 1.0 - beta1;
+    double oneMinusB2  = 1.0 - beta2;
+    double *m          = ((Matrix *)self.state[@"firstMoments"])->matrix;
+    double *v          = ((Matrix *)self.state[@"secondMoments"])->matrix;
+    double *d          = ((Matrix *)self.state[@"scratch"])->matrix;
+    double *g          = gradients->matrix;
+    double *x          = values->matrix;
+    
+    // Decoupled weight decay: x = (1 - rate * wd) * x
+    if (weightDecay > 0)
+    {
+        double decay = 1.0 - rate * weightDecay;
+        vDSP_vsmulD(x, 1, &decay, x, 1, k);
+    }
+    
+    // m = b1 * m + (1 - b1) * g
+    vDSP_vsmsmaD(m, 1, &beta1, g, 1, &oneMinusB1, m, 1, k);
+    
+    // v = b2 * v + (1 - b2) * g^2
+    vDSP_vsqD(g, 1, d, 1, k);
+    vDSP_vsmsmaD(v, 1, &beta2, d, 1, &oneMinusB2, v, 1, k);
+    
+    // Bias correction is folded into the step size and epsilon
+    double correction2 = sqrt(1.0 - pow(beta2, step));
+    double stepSize    = -rate * correction2 / (1.0 - pow(beta1, step));
+    double epsilonHat  = epsilon * correction2;
+    
+    // x = x - step * m / (sqrt(v) + eps)
+    vvsqrt(d, v, &k);
+    vDSP_vsaddD(d, 1, &epsilonHat, d, 1, k);
+    vDSP_vdivD(d, 1, m, 1, d, 1, k);
+    vDSP_vsmaD(d, 1, &stepSize, x, 1, x, 1, k);
+}
+
+@end
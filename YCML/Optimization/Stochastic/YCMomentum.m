@@ -0,0 +1,72 @@
+//
+//  YCMomentum.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCMomentum.h"
+
+@implementation YCMomentum
+
+- (instancetype)initWithProblem:(NSObject<YCProblem> *)aProblem settings:(NSDictionary *)settings
+{
+    self = [super initWithProblem:aProblem settings:settings];
+    if (self)
+    {
+        self.settings[@"Learning Rate"] = @0.01;
+        self.settings[@"Momentum"]      = @0.9;
+        self.settings[@"Nesterov"]      = @YES;
+    }
+    return self;
+}
+
+- (void)prepareStateWithParameterCount:(int)count
+{
+    self.state[@"velocity"] = [Matrix matrixOfRows:count columns:1];
+    self.state[@"scratch"]  = [Matrix matrixOfRows:count columns:1];
+}
+
+- (void)updateValues:(Matrix *)values gradients:(Matrix *)gradients rate:(double)rate step:(int)step
+{
+    int k          = (int)values.count;
+    double mu      = [self.settings[@"Momentum"] doubleValue];
+    double negRate = -rate;
+    double *v      = ((Matrix *)self.state[@"velocity"])->matrix;
+    double *g      = gradients->matrix;
+    
+    // v = mu * v + g
+    vDSP_vsmaD(v, 1, &mu, g, 1, v, 1, k);
+    
+    if ([self.settings[@"Nesterov"] boolValue])
+    {
+        // x = x - rate * (g + mu * v)
+        double *d = ((Matrix *)self.state[@"scratch"])->matrix;
+        vDSP_vsmaD(v, 1, &mu, g, 1, d, 1, k);
+        vDSP_vsmaD(d, 1, &negRate, values->matrix, 1, values->matrix, 1, k);
+    }
+    else
+    {
+        // x = x - rate * v
+        vDSP_vsmaD(v, 1, &negRate, values->matrix, 1, values->matrix, 1, k);
+    }
+}
+
+@end
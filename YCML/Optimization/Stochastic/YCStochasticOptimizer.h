@@ -0,0 +1,67 @@
+//
+//  YCStochasticOptimizer.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import Foundation;
+#import "YCOptimizer.h"
+@class Matrix;
+
+/**
+ Abstract base class for first-order stochastic optimizers. On every
+ iteration the receiver requests the derivatives of the problem, which,
+ for problems that support sampling (e.g. YCBackPropProblem with a positive
+ sampleCount), are evaluated on a fresh minibatch. Subclasses implement
+ the actual parameter update.
+ 
+ Settings:
+ "Learning Rate"         : The base learning rate.
+ "Schedule"              : One of "Constant", "Exponential" or "Cosine".
+ "Decay"                 : Per-step multiplier of the "Exponential" schedule.
+ "Minimum Learning Rate" : Learning rate at the end of the "Cosine" schedule,
+                           which anneals over "Iterations" steps.
+ */
+@interface YCStochasticOptimizer : YCOptimizer
+
+/**
+ Returns the learning rate for step |step| (starting at 1), according
+ to the receiver's schedule settings.
+ */
+- (double)learningRateForStep:(int)step;
+
+/**
+ Allocates any optimizer-specific state. Called once, before the first update.
+ 
+ @param count The number of parameters.
+ */
+- (void)prepareStateWithParameterCount:(int)count;
+
+/**
+ Updates |values| in place, for descent along |gradients|. Must be
+ overridden in subclasses.
+ 
+ @param values    The current parameter values.
+ @param gradients The derivatives of the objective, oriented for minimization.
+ @param rate      The learning rate for this step.
+ @param step      The update step, starting at 1.
+ */
+- (void)updateValues:(Matrix *)values gradients:(Matrix *)gradients rate:(double)rate step:(int)step;
+
+@end
@@ -0,0 +1,142 @@
+//
+//  YCStochasticOptimizer.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCStochasticOptimizer.h"
+#import "YCDerivativeProblem.h"
+
+@implementation YCStochasticOptimizer
+
+- (instancetype)initWithProblem:(NSObject<YCProblem> *)aProblem settings:(NSDictionary *)settings
+{
+    self = [super initWithProblem:aProblem settings:settings];
+    if (self)
+    {
+        self.settings[@"Learning Rate"]         = @0.001;
+        self.settings[@"Schedule"]              = @"Constant";
+        self.settings[@"Decay"]                 = @0.999;
+        self.settings[@"Minimum Learning Rate"] = @0;
+        self.settings[@"Iterations"]            = @1000;
+    }
+    return self;
+}
+
+- (BOOL)iterate:(int)iteration
+{
+    BOOL maximize = [self.problem.modes i:0 j:0] > 0;
+    int k = self.problem.parameterCount;
+    
+    if (!self.state[@"values"])
+    {
+        Matrix *newValues = [Matrix matrixOfRows:k columns:1];
+        
+        Matrix *initialRanges = [self.problem initialValuesRangeHint];
+        
+        for (int i=0; i<k; i++)
+        {
+            double start = [initialRanges valueAtRow:i column:0];
+            double range = [initialRanges valueAtRow:i column:1] - start;
+            [newValues setValue:((double)arc4random() / 0x100000000) * range + start
+                            row:i column:0];
+        }
+        self.state[@"values"]    = newValues;
+        self.state[@"gradients"] = [Matrix matrixOfRows:k columns:1];
+        self.state[@"step"]      = @0;
+        [self prepareStateWithParameterCount:k];
+    }
+    else
+    {
+        Matrix *values    = self.state[@"values"];
+        Matrix *gradients = self.state[@"gradients"];
+        [(NSObject<YCDerivativeProblem> *)self.problem derivatives:gradients parameters:values];
+        if (maximize)
+        {
+            vDSP_vnegD(gradients->matrix, 1, gradients->matrix, 1, k);
+        }
+        int step = [self.state[@"step"] intValue] + 1;
+        self.state[@"step"] = @(step);
+        [self updateValues:values gradients:gradients rate:[self learningRateForStep:step] step:step];
+    }
+    
+    if (iteration % 10 == 0 && self.settings[@"Target"])
+    {
+        Matrix *values = self.state[@"values"];
+        double target = [self.settings[@"Target"] doubleValue];
+        
+        Matrix *objectiveValues = [Matrix matrixOfRows:self.problem.objectiveCount columns:1];
+        [self.problem evaluate:objectiveValues parameters:values];
+        double best = [objectiveValues sum];
+        self.state[@"best"] = @(best);
+        if (maximize ? best >= target : best <= target) return NO;
+    }
+    return YES;
+}
+
+- (double)learningRateForStep:(int)step
+{
+    double rate       = [self.settings[@"Learning Rate"] doubleValue];
+    NSString *schedule = self.settings[@"Schedule"];
+    
+    if ([schedule isEqualToString:@"Exponential"])
+    {
+        return rate * pow([self.settings[@"Decay"] doubleValue], step - 1);
+    }
+    else if ([schedule isEqualToString:@"Cosine"])
+    {
+        double minimum = [self.settings[@"Minimum Learning Rate"] doubleValue];
+        double horizon = MAX(1, [self.settings[@"Iterations"] intValue]);
+        double t       = MIN(1.0, (step - 1) / horizon);
+        return minimum + 0.5 * (rate - minimum) * (1.0 + cos(M_PI * t));
+    }
+    return rate;
+}
+
+- (void)prepareStateWithParameterCount:(int)count
+{
+    // Optionally implement in subclass
+}
+
+- (void)updateValues:(Matrix *)values gradients:(Matrix *)gradients rate:(double)rate step:(int)step
+{
+    @throw [NSInternalInconsistencyException initWithFormat:
+            @"You must override %@ in subclass %@", NSStringFromSelector(_cmd), [self class]];
+}
+
+- (NSArray *)bestParameters
+{
+    if (!self.state[@"values"]) return nil;
+    return @[self.state[@"values"]];
+}
+
+- (NSArray *)bestObjectives
+{
+    if (!self.state[@"best"]) return nil;
+    return @[self.state[@"best"]];
+}
+
+- (NSArray *)bestConstraints
+{
+    return @[@0];
+}
+
+@end
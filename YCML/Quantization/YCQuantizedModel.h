@@ -0,0 +1,107 @@
+//
+//  YCQuantizedModel.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCSupervisedModel.h"
+@class Matrix, YCDataframe, YCFullyConnectedLayer;
+
+// Sizes, buffer offsets and requantization parameters of a quantized layer
+typedef struct
+{
+    int32_t inputSize;
+    int32_t outputSize;
+    int32_t weightOffset;
+    int32_t biasOffset;
+    int32_t tableOffset;    // -1 for the output layer
+    int32_t zeroPoint;      // Pre-activation zero point (hidden layers)
+    double multiplier;      // Accumulator to pre-activation scale (hidden),
+                            // or to real value (output layer)
+} YCQuantizedLayer;
+
+/**
+ An int8 quantized version of a trained YCFFN or YCLinRegModel, intended
+ for batch scoring. Weights are quantized symmetrically with one scale per
+ layer, and activations asymmetrically with a per-layer scale and zero
+ point, calibrated on sample data. Inputs are quantized once, with the
+ model's input transform folded in; each layer then runs an integer
+ matrix product with int32 accumulation, and hidden layers requantize
+ their pre-activations and apply the activation function through a
+ 256-entry lookup table that directly produces the next layer's int8
+ input. Only the output layer is dequantized, before its activation
+ function and the output transform are applied.
+ 
+ The quantized model is immutable, and stores roughly one byte per weight.
+ */
+@interface YCQuantizedModel : YCSupervisedModel
+{
+    NSData *_layerInfo;         // YCQuantizedLayer, one per layer
+    NSData *_weights;           // int8_t, per layer OxI
+    NSData *_biases;            // int32_t, per layer O
+    NSData *_tables;            // int8_t, 256 per hidden layer
+    NSData *_inputQuantization; // double, multiplier and offset per input
+    Matrix *_outputTransform;
+    YCFullyConnectedLayer *_outputActivation; // Of the output layer's class
+}
+
+/**
+ Quantizes |model|, calibrating activation ranges with |input|.
+ 
+ @param model The trained YCFFN or YCLinRegModel.
+ @param input The calibration input (NxS), one sample per column.
+ 
+ @return The quantized model.
+ */
++ (instancetype)quantizedModelWithModel:(YCSupervisedModel *)model calibrationMatrix:(Matrix *)input;
+
+/**
+ Quantizes |model|, calibrating activation ranges with a sample dataframe,
+ which is converted using the model's input conversion array.
+ */
++ (instancetype)quantizedModelWithModel:(YCSupervisedModel *)model calibrationDataframe:(YCDataframe *)input;
+
+- (instancetype)initWithModel:(YCSupervisedModel *)model calibrationMatrix:(Matrix *)input;
+
+/**
+ Compares the predictions of the receiver with those of |model|. The
+ accuracy report for the calibration set is also stored in the receiver's
+ statistics.
+ 
+ @param model The original model.
+ @param input The input matrix (NxS).
+ 
+ @return A dictionary with the "RMSE", "Relative RMSE" (with respect to the
+ root mean square of the original predictions) and "Maximum Absolute Error"
+ of the receiver's predictions.
+ */
+- (NSDictionary *)accuracyReportWithModel:(YCSupervisedModel *)model inputMatrix:(Matrix *)input;
+
+/**
+ Returns the number of layers of the receiver.
+ */
+@property (readonly) int layerCount;
+
+/**
+ Returns the number of bytes taken up by the receiver's quantized weights,
+ biases and lookup tables.
+ */
+@property (readonly) NSUInteger parameterBytes;
+
+@end
@@ -0,0 +1,375 @@
+//
+//  YCQuantizedModel.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+@import YCMatrix;
+@import Accelerate;
+#import "YCQuantizedModel.h"
+#import "YCFFN.h"
+#import "YCLinRegModel.h"
+#import "YCFullyConnectedLayer.h"
+#import "YCLinearLayer.h"
+#import "YCDataframe.h"
+#import "YCDataframe+Matrix.h"
+#import "YCRegressionMetrics.h"
+
+// I: Input size
+// O: Output size
+// S: Sample count
+
+// Number of samples quantized and propagated together
+#define CHUNK_SIZE 256
+
+typedef struct
+{
+    double scale;
+    int zeroPoint;
+} YCQuantization;
+
+static inline int8_t YCClampInt8(long value)
+{
+    return (int8_t)MAX(-128, MIN(127, value));
+}
+
+// Asymmetric quantization of a range, which is extended to include zero
+static YCQuantization YCQuantizationOfRange(double min, double max)
+{
+    min = MIN(min, 0);
+    max = MAX(max, 0);
+    YCQuantization q;
+    q.scale = max > min ? (max - min) / 255.0 : 1.0;
+    q.zeroPoint = (int)MAX(-128, MIN(127, lrint(-128 - min / q.scale)));
+    return q;
+}
+
+static YCQuantization YCQuantizationOfMatrix(Matrix *matrix)
+{
+    return YCQuantizationOfRange(matrix.min, matrix.max);
+}
+
+// Plain loop, so that the compiler emits widening SIMD multiply-adds
+static inline int32_t YCDotInt8(const int8_t *a, const int8_t *b, int n)
+{
+    int32_t sum = 0;
+    for (int i=0; i<n; i++)
+    {
+        sum += (int32_t)a[i] * (int32_t)b[i];
+    }
+    return sum;
+}
+
+@implementation YCQuantizedModel
+
++ (instancetype)quantizedModelWithModel:(YCSupervisedModel *)model calibrationMatrix:(Matrix *)input
+{
+    return [[self alloc] initWithModel:model calibrationMatrix:input];
+}
+
++ (instancetype)quantizedModelWithModel:(YCSupervisedModel *)model calibrationDataframe:(YCDataframe *)input
+{
+    Matrix *matrix = [input getMatrixUsingConversionArray:model.properties[@"InputConversionArray"]];
+    return [[self alloc] initWithModel:model calibrationMatrix:matrix];
+}
+
+- (instancetype)initWithModel:(YCSupervisedModel *)model calibrationMatrix:(Matrix *)input
+{
+    self = [super init];
+    if (self)
+    {
+        NSArray *layers;
+        Matrix *inputTransform;
+        if ([model isKindOfClass:[YCFFN class]])
+        {
+            YCFFN *ffn = (YCFFN *)model;
+            layers = ffn.layers;
+            inputTransform = ffn.inputTransform;
+            _outputTransform = ffn.outputTransform;
+        }
+        else if ([model isKindOfClass:[YCLinRegModel class]])
+        {
+            // Theta: (N+1)xO, last row holds the bias
+            YCLinRegModel *linReg = (YCLinRegModel *)model;
+            Matrix *theta = linReg.theta;
+            int N = theta->rows - 1;
+            int O = theta->columns;
+            YCLinearLayer *layer = [YCLinearLayer layerWithInputSize:N outputSize:O];
+            layer.weightMatrix = [Matrix matrixFromArray:theta->matrix rows:N columns:O mode:YCMCopy];
+            layer.biasVector = [Matrix matrixFromArray:theta->matrix + N * O rows:O columns:1 mode:YCMCopy];
+            layers = @[layer];
+            inputTransform = linReg.inputTransform;
+            _outputTransform = linReg.outputTransform;
+        }
+        NSAssert(layers.count, @"Model type not supported or model not trained");
+        NSAssert(input->rows == [layers[0] inputSize], @"Input size mismatch");
+        
+        self.properties = [model.properties mutableCopy];
+        _outputActivation = [[[layers lastObject] class] layerWithInputSize:1 outputSize:1];
+        
+        // Calibrate the input, folding the input transform into its quantization
+        Matrix *x = inputTransform ? [input matrixByRowWiseMapUsing:inputTransform] : input;
+        YCQuantization inputQ = YCQuantizationOfMatrix(x);
+        int N = x->rows;
+        NSMutableData *inputQuantization = [NSMutableData dataWithLength:2 * N * sizeof(double)];
+        double *iq = inputQuantization.mutableBytes;
+        for (int i=0; i<N; i++)
+        {
+            double a = inputTransform ? inputTransform->matrix[2*i] : 1;
+            double b = inputTransform ? inputTransform->matrix[2*i + 1] : 0;
+            iq[2*i]     = a / inputQ.scale;
+            iq[2*i + 1] = b / inputQ.scale + inputQ.zeroPoint;
+        }
+        
+        NSMutableData *layerInfo = [NSMutableData data];
+        NSMutableData *weights   = [NSMutableData data];
+        NSMutableData *biases    = [NSMutableData data];
+        NSMutableData *tables    = [NSMutableData data];
+        
+        for (int l=0, L=(int)layers.count; l<L; l++)
+        {
+            YCFullyConnectedLayer *layer = layers[l];
+            int I = layer.inputSize;
+            int O = layer.outputSize;
+            double *W = layer.weightMatrix->matrix;
+            double *B = layer.biasVector->matrix;
+            
+            YCQuantizedLayer info;
+            info.inputSize    = I;
+            info.outputSize   = O;
+            info.weightOffset = (int32_t)weights.length;
+            info.biasOffset   = (int32_t)(biases.length / sizeof(int32_t));
+            info.tableOffset  = -1;
+            info.zeroPoint    = 0;
+            
+            // Symmetric per-layer weight quantization, stored transposed (OxI)
+            double maxWeight = 0;
+            for (int k=0, count=I*O; k<count; k++) maxWeight = MAX(maxWeight, fabs(W[k]));
+            double weightScale = maxWeight > 0 ? maxWeight / 127.0 : 1.0;
+            double accumulatorScale = weightScale * inputQ.scale;
+            
+            NSMutableData *qW = [NSMutableData dataWithLength:I * O];
+            NSMutableData *qB = [NSMutableData dataWithLength:O * sizeof(int32_t)];
+            int8_t *w = qW.mutableBytes;
+            int32_t *b = qB.mutableBytes;
+            for (int o=0; o<O; o++)
+            {
+                long rowSum = 0;
+                for (int i=0; i<I; i++)
+                {
+                    w[o * I + i] = YCClampInt8(lrint(W[i * O + o] / weightScale));
+                    rowSum += w[o * I + i];
+                }
+                // The input zero point is folded into the bias
+                long bias = lrint(B[o] / accumulatorScale) - inputQ.zeroPoint * rowSum;
+                b[o] = (int32_t)MAX(INT32_MIN, MIN(INT32_MAX, bias));
+            }
+            [weights appendData:qW];
+            [biases appendData:qB];
+            
+            // Float reference pass, for calibrating the next ranges
+            Matrix *z = [layer.weightMatrix matrixByTransposingAndMultiplyingWithRight:x];
+            for (int o=0; o<O; o++)
+            {
+                vDSP_vsaddD(z->matrix + o * z->columns, 1, &B[o], z->matrix + o * z->columns, 1,
+                            z->columns);
+            }
+            Matrix *y = [Matrix matrixFromMatrix:z];
+            [layer activationFunctionOnValues:y->matrix count:(int)y.count];
+            
+            if (l < L - 1)
+            {
+                YCQuantization preQ  = YCQuantizationOfMatrix(z);
+                YCQuantization nextQ = YCQuantizationOfMatrix(y);
+                info.zeroPoint   = preQ.zeroPoint;
+                info.multiplier  = accumulatorScale / preQ.scale;
+                info.tableOffset = (int32_t)tables.length;
+                
+                // Activation lookup table, from pre-activation to next layer input
+                Matrix *levels = [Matrix matrixOfRows:1 columns:256];
+                for (int q=-128; q<128; q++)
+                {
+                    levels->matrix[q + 128] = preQ.scale * (q - preQ.zeroPoint);
+                }
+                [layer activationFunctionOnValues:levels->matrix count:256];
+                int8_t table[256];
+                for (int k=0; k<256; k++)
+                {
+                    table[k] = YCClampInt8(lrint(levels->matrix[k] / nextQ.scale) + nextQ.zeroPoint);
+                }
+                [tables appendBytes:table length:256];
+                inputQ = nextQ;
+            }
+            else
+            {
+                info.multiplier = accumulatorScale;
+            }
+            [layerInfo appendBytes:&info length:sizeof(YCQuantizedLayer)];
+            x = y;
+        }
+        
+        _layerInfo         = layerInfo;
+        _weights           = weights;
+        _biases            = biases;
+        _tables            = tables;
+        _inputQuantization = inputQuantization;
+        
+        [self.statistics addEntriesFromDictionary:[self accuracyReportWithModel:model inputMatrix:input]];
+    }
+    return self;
+}
+
+- (Matrix *)activateWithMatrix:(Matrix *)matrix
+{
+    NSAssert(matrix->rows == self.inputSize, @"Input size mismatch");
+    
+    const YCQuantizedLayer *layers = _layerInfo.bytes;
+    const int8_t *weights  = _weights.bytes;
+    const int32_t *biases  = _biases.bytes;
+    const int8_t *tables   = _tables.bytes;
+    const double *iq       = _inputQuantization.bytes;
+    int L = self.layerCount;
+    int N = self.inputSize;
+    int O = self.outputSize;
+    int S = matrix->columns;
+    Matrix *output = [Matrix matrixOfRows:O columns:S];
+    double *out = output->matrix;
+    const double *in = matrix->matrix;
+    
+    int width = N;
+    for (int l=0; l<L; l++) width = MAX(width, layers[l].outputSize);
+    
+    // Chunks are independent, and write to distinct output columns.
+    // Activations are kept sample-major, so that each dot product is contiguous.
+    size_t chunkCount = (S + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunk) {
+        int c0 = (int)chunk * CHUNK_SIZE;
+        int C = MIN(CHUNK_SIZE, S - c0);
+        int8_t *buffers[2] = {malloc(C * width), malloc(C * width)};
+        int current = 0;
+        
+        // 1. Quantize the input chunk, with the input transform folded in
+        int8_t *x = buffers[current];
+        for (int i=0; i<N; i++)
+        {
+            const double *row = in + i * S + c0;
+            double m = iq[2*i], c = iq[2*i + 1];
+            for (int s=0; s<C; s++)
+            {
+                x[s * N + i] = YCClampInt8(lrint(row[s] * m + c));
+            }
+        }
+        
+        // 2. Integer layers; hidden layers requantize through their lookup tables
+        for (int l=0; l<L; l++)
+        {
+            const YCQuantizedLayer *layer = &layers[l];
+            int I = layer->inputSize;
+            int lO = layer->outputSize;
+            const int8_t *w = weights + layer->weightOffset;
+            const int32_t *b = biases + layer->biasOffset;
+            
+            if (l < L - 1)
+            {
+                const int8_t *table = tables + layer->tableOffset;
+                int8_t *y = buffers[1 - current];
+                for (int s=0; s<C; s++)
+                {
+                    const int8_t *xs = x + s * I;
+                    int8_t *ys = y + s * lO;
+                    for (int o=0; o<lO; o++)
+                    {
+                        int32_t acc = YCDotInt8(w + o * I, xs, I) + b[o];
+                        int8_t q = YCClampInt8(lrint(acc * layer->multiplier) + layer->zeroPoint);
+                        ys[o] = table[q + 128];
+                    }
+                }
+                current = 1 - current;
+                x = y;
+            }
+            else
+            {
+                // 3. Dequantize the output layer
+                for (int s=0; s<C; s++)
+                {
+                    const int8_t *xs = x + s * I;
+                    for (int o=0; o<lO; o++)
+                    {
+                        int32_t acc = YCDotInt8(w + o * I, xs, I) + b[o];
+                        out[o * S + c0 + s] = acc * layer->multiplier;
+                    }
+                }
+            }
+        }
+        
+        free(buffers[0]);
+        free(buffers[1]);
+    });
+    
+    // 4. Output activation and transform, in double precision
+    if (![_outputActivation isMemberOfClass:[YCLinearLayer class]])
+    {
+        [_outputActivation activationFunctionOnValues:out count:O * S];
+    }
+    if (_outputTransform)
+    {
+        double *transform = _outputTransform->matrix;
+        for (int i=0; i<O; i++)
+        {
+            double *row = out + i * S;
+            vDSP_vsmsaD(row, 1, &transform[2*i], &transform[2*i + 1], row, 1, S);
+        }
+    }
+    return output;
+}
+
+- (NSDictionary *)accuracyReportWithModel:(YCSupervisedModel *)model inputMatrix:(Matrix *)input
+{
+    Matrix *expected = [model activateWithMatrix:input];
+    Matrix *actual   = [self activateWithMatrix:input];
+    double rmse      = sqrt(MSE(expected, actual));
+    double rms       = sqrt([[expected matrixByElementWiseMultiplyWith:expected] sum] / expected.count);
+    Matrix *error    = [[expected matrixBySubtracting:actual] matrixByAbsolute];
+    return @{@"RMSE"                   : @(rmse),
+             @"Relative RMSE"          : @(rms > 0 ? rmse / rms : 0),
+             @"Maximum Absolute Error" : @(error.max)};
+}
+
+- (int)layerCount
+{
+    return (int)(_layerInfo.length / sizeof(YCQuantizedLayer));
+}
+
+- (NSUInteger)parameterBytes
+{
+    return _weights.length + _biases.length + _tables.length;
+}
+
+- (int)inputSize
+{
+    return (int)(_inputQuantization.length / (2 * sizeof(double)));
+}
+
+- (int)outputSize
+{
+    const YCQuantizedLayer *layers = _layerInfo.bytes;
+    return self.layerCount ? layers[self.layerCount - 1].outputSize : 0;
+}
+
+@end
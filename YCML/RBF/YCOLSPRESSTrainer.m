@@ -42,11 +42,9 @@
     double outputSize         = outp->rows; // == O
     double basisFunctionWidth = [[self.settings objectForKey:@"Kernel Width"] doubleValue];
     int maxRegressors         = [self.settings[@"Max Regressors"] intValue];
-    // inp -> NxS
-    model.widths              = [Matrix matrixOfRows:cols
-                                             columns:1
-                                               value:basisFunctionWidth]; // -> Sx1
-    model.centers             = [Matrix matrixFromMatrix:inp];// -> NxS
+    // inp -> NxS, candidate centers -> NxM
+    Matrix *centers           = [self candidateCentersWithInput:inp];
+    int M                     = centers->columns;
     
     // This will hold all the *orthogonalized* vectors up till the current (k) step
     NSMutableArray *W         = [NSMutableArray arrayWithCapacity:cols];
@@ -55,14 +53,22 @@
     NSMutableArray *selectedRegressors = [[NSMutableArray alloc] init];
     
     // This will hold boolean values to denote whether an input has been selected as regressor.
-    bool *isSelected          = calloc(cols, sizeof(bool));
+    bool *isSelected          = calloc(M, sizeof(bool));
     
-    // Find design matrix (aka regressor matrix) for full-sample width hidden layer (D == S => H:SxS)
-    // Cache of all orthogonalized regressors of the last step
-    NSMutableArray *lastOrtho;
-    @autoreleasepool {
-        lastOrtho = [[[self initialDesignMatrixWithInput:inp widths:model.widths]
-                      columnsAsNSArray] mutableCopy];
+    // Find design matrix (aka regressor matrix) of the candidate centers (H':MxS)
+    // Cache of all orthogonalized regressors of the last step, initially
+    // referencing the rows of the design matrix
+    NS_VALID_UNTIL_END_OF_SCOPE
+    Matrix *candidates        = [self candidateDesignMatrixWithInput:inp
+                                                             centers:centers
+                                                               width:basisFunctionWidth];
+    NSMutableArray *lastOrtho = [NSMutableArray arrayWithCapacity:M];
+    for (int i=0; i<M; i++)
+    {
+        [lastOrtho addObject:[Matrix matrixFromArray:candidates->matrix + i * (int)cols
+                                                rows:cols
+                                             columns:1
+                                                mode:YCMWeak]];
     }
     
     // For PRESS: These will hold Ksi and B values for each step, for each regressor
@@ -73,7 +79,7 @@
     double prevJki            = [[outp matrixByMultiplyingWithRight:[outp matrixByTransposing]] trace];
     
     
-    for (int k=0; k<cols; k++)
+    for (int k=0; k<M; k++)
     {
         @autoreleasepool
         {
@@ -90,7 +96,7 @@
             Matrix *selectedB = [Matrix matrixOfRows:1 columns:cols]; // 1xS
             
             // Here select the next regressor
-            for (int i=0; i<cols; i++)
+            for (int i=0; i<M; i++)
             {
                 if (isSelected[i]) continue;
                 @autoreleasepool
@@ -177,7 +183,7 @@
             [W addObject:currentW];
             
             // Here add the real regressor and associated width!
-            [selectedRegressors addObject:[model.centers column:chosenRegressorIndex]];
+            [selectedRegressors addObject:[centers column:chosenRegressorIndex]];
             
             // Notify delegate
             
@@ -211,6 +217,7 @@
     // Assign network statistics dictionary
     model.statistics[@"Error"]      = @(totalError);
     model.statistics[@"Regressors"] = @([selectedRegressors count]);
+    model.statistics[@"Candidates"] = @(M);
     
     // Clean up
     free(isSelected);
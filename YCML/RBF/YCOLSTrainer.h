@@ -29,6 +29,31 @@
 
 - (void)weightsFor:(YCRBFNet *)model input:(Matrix *)input output:(Matrix *)output;
 
-- (Matrix *)initialDesignMatrixWithInput:(Matrix *)input widths:(Matrix *)widths;
+/**
+ Returns the SxS design matrix of |input| against all of its samples, using
+ the first element of |widths| as the common basis function width.
+ */
+- (Matrix *)initialDesignMatrixWithInput:(Matrix *)input widths:(Matrix *)widths
+__deprecated_msg("Use candidateDesignMatrixWithInput:centers:width:");
+
+/**
+ Returns the samples of |input| that are considered as centers during
+ forward selection (NxM). When the "Candidates" setting is zero or not
+ smaller than the sample count, all samples are returned. Otherwise, M
+ samples are chosen according to the "Candidate Selection" setting:
+ uniformly at random ("Random"), through k-means++ seeding ("KMeans"), or
+ as the samples nearest to the points of a Sobol ("Sobol") or Halton
+ ("Halton") sequence spanning the bounding box of the input.
+ */
+- (Matrix *)candidateCentersWithInput:(Matrix *)input;
+
+/**
+ Returns the design matrix of |input| against the candidate |centers|, with
+ one row per candidate (MxS). Rows are evaluated concurrently in chunks,
+ using a single GEMM call for the distances of each chunk.
+ */
+- (Matrix *)candidateDesignMatrixWithInput:(Matrix *)input
+                                   centers:(Matrix *)centers
+                                     width:(double)width;
 
 @end
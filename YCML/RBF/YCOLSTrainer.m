@@ -23,6 +23,15 @@
 #import "YCOLSTrainer.h"
 #import "YCRBFNet.h"
 @import YCMatrix;
+@import Accelerate;
+
+// Minimum number of candidate regressors per thread, during forward selection
+#define CANDIDATE_BLOCK 64
+
+// Minimum number of candidate design matrix rows per concurrent chunk
+#define DESIGN_CHUNK 16
+
+#define ARC4RANDOM_MAX 0x100000000
 
 @implementation YCOLSTrainer
 
@@ -39,6 +48,8 @@
         self.settings[@"Error Tolerance"] = @0.02;
         self.settings[@"Max Regressors"]  = @300;
         self.settings[@"Lambda"] = @0;
+        self.settings[@"Candidates"] = @0; // 0 = all samples
+        self.settings[@"Candidate Selection"] = @"Random"; // Random, KMeans, Sobol, Halton
     }
     return self;
 }
@@ -78,135 +89,92 @@
 {
     double tolerance          = [[self.settings objectForKey:@"Error Tolerance"] doubleValue];
     double totalError         = 1;
-    double cols               = inp->columns; // == S
+    int O                     = outp->rows;
     double basisFunctionWidth = [[self.settings objectForKey:@"Kernel Width"] doubleValue];
     int maxRegressors         = [self.settings[@"Max Regressors"] intValue];
     double lambda             = [self.settings[@"Lambda"] doubleValue];
-    // inp -> NxS
-    model.widths              = [Matrix matrixOfRows:cols
-                                               columns:1
-                                                 value:basisFunctionWidth]; // -> Sx1
-    model.centers             = [Matrix matrixFromMatrix:inp];// -> NxS
-    
-    // Explode output rows as NSArrays
-    NSArray *OA               = [outp rowsAsNSArray];
+    // inp -> NxS, candidate centers -> NxM
+    Matrix *centers           = [self candidateCentersWithInput:inp];
+    int M                     = centers->columns;
     
     // Find the trace of the output matrix
-    double dTrace             = [[outp matrixByMultiplyingWithRight:[outp matrixByTransposing]] trace];
+    double dTrace             = [outp dotWith:outp];
     
-    // This will hold all the *orthogonalized* vectors up till the current (k) step
-    NSMutableArray *W         = [NSMutableArray array];
+    // Candidate regressors, one per row (MxS), orthogonalized in place
+    // against each selected regressor
+    Matrix *candidates;
+    @autoreleasepool {
+        candidates = [self candidateDesignMatrixWithInput:inp centers:centers width:basisFunctionWidth];
+    }
     
     // This will hold the subset of inputs selected as regressors.
-    NSMutableArray *selectedRegressors = [[NSMutableArray alloc] init];
+    NSMutableIndexSet *selectedRegressors = [NSMutableIndexSet indexSet];
     
     // This will hold boolean values to denote whether an input has been selected as regressor.
-    bool *isSelected          = calloc(cols, sizeof(bool));
+    bool *isSelected          = calloc(M, sizeof(bool));
     
-    // Find design matrix (aka regressor matrix) for full-sample width hidden layer (D == S => H:SxS)
-    // Cache of all orthogonalized regressors of the last step
-    NSMutableArray *lastOrtho;
-    @autoreleasepool {
-        lastOrtho = [[[self initialDesignMatrixWithInput:inp widths:model.widths]
-                      columnsAsNSArray] mutableCopy];
-    }
+    double *ERR               = malloc(M * sizeof(double));
+    double *projections       = malloc(M * sizeof(double));
+    double *outputDots        = malloc(M * O * sizeof(double));
+    int lastSelected          = -1;
     
-    for (int k=0; k<cols; k++)
+    for (int k=0; k<M; k++)
     {
-        @autoreleasepool
+        [self scoreCandidates:candidates output:outp isSelected:isSelected
+                 lastSelected:lastSelected lambda:lambda trace:dTrace ERR:ERR
+                  projections:projections outputDots:outputDots];
+        
+        // Here select the next regressor (the one with the largest Error Reduction Ratio)
+        int maxERRIndex = -1;
+        double maxERR = -1;
+        for (int i=0; i<M; i++)
         {
-            int maxERRIndex = -1;
-            double maxERR = -1;
-            Matrix *currentW;
-            
-            // Select last selected orthonormal regressor
-            Matrix *wl = [W lastObject];
-            
-            // Here select the next regressor
-            for (int i=0; i<cols; i++)
-            {
-                if (isSelected[i]) continue;
-                @autoreleasepool
-                {
-                    // Select i-th regressor's orthogonal P-column
-                    Matrix *wki = lastOrtho[i];
-                    
-                    // Orthogonalize to last orthonormal P-vector
-                    if (wl)
-                    {
-                        double a = [wl dotWith:wki]/[wl dotWith:wl];
-                        wki = [wki matrixBySubtracting:[wl matrixByMultiplyingWithScalar: a]];
-                        lastOrtho[i] = wki;
-                    }
-                    
-                    double wkiwki = [wki dotWith:wki];
-                    
-                    // Calculate ERR (= Error Reduction Ratio)
-                    
-                    double sumg2 = 0;
-                    
-                    // Check how much the regressor contributes to each output
-                    for (Matrix *o in OA)
-                    {
-                        double gki = [wki dotWith:o]/wkiwki;
-                        sumg2 += gki*gki;
-                    }
-                    
-                    double ERR = (sumg2*(wkiwki + lambda))/dTrace;
-                    
-                    // If the current ERR is larger than the max ERR, select this regressor.
-                    if (ERR > maxERR)
-                    {
-                        maxERRIndex = i;
-                        maxERR = ERR;
-                        currentW = wki;
-                    }
-                }
-            }
-            
-            // Check if a regressor has been selected
-            if (maxERRIndex < 0)
-            {
-                NSLog(@"Unable to select %ith regressor", k);
-                break;
-            }
-            
-            // If yes, update isSelected and W
-            isSelected[maxERRIndex] = true;
-            [W addObject:currentW];
-            
-            // Here add the real regressor! From the inp matrix!
-            [selectedRegressors addObject:[inp column:maxERRIndex]];
-            
-            // Update error
-            totalError -= maxERR;
-            
-            // Notify delegate
-            if (self.delegate && [self.delegate respondsToSelector:@selector(stepComplete:)])
+            if (!isSelected[i] && ERR[i] > maxERR)
             {
-                NSDictionary *info = @{@"Status"        : @"Forward Selection",
-                                       @"Error"         : @(totalError),
-                                       @"Step"          : @(k),
-                                       @"Width"         : @(basisFunctionWidth)};
-                [self.delegate stepComplete:info];
+                maxERRIndex = i;
+                maxERR = ERR[i];
             }
-            
-            // Break if tolerance is reached or stopping command is issued
-            if (totalError <= tolerance || self.shouldStop) break;
-            
-            // Break if maximum number of regressors reached
-            if (maxRegressors > 0 && k > maxRegressors) break;
         }
+        
+        // Check if a regressor has been selected
+        if (maxERRIndex < 0)
+        {
+            NSLog(@"Unable to select %ith regressor", k);
+            break;
+        }
+        
+        // If yes, update isSelected
+        isSelected[maxERRIndex] = true;
+        lastSelected = maxERRIndex;
+        [selectedRegressors addIndex:maxERRIndex];
+        
+        // Update error
+        totalError -= maxERR;
+        
+        // Notify delegate
+        if (self.delegate && [self.delegate respondsToSelector:@selector(stepComplete:)])
+        {
+            NSDictionary *info = @{@"Status"        : @"Forward Selection",
+                                   @"Error"         : @(totalError),
+                                   @"Step"          : @(k),
+                                   @"Width"         : @(basisFunctionWidth)};
+            [self.delegate stepComplete:info];
+        }
+        
+        // Break if tolerance is reached or stopping command is issued
+        if (totalError <= tolerance || self.shouldStop) break;
+        
+        // Break if maximum number of regressors reached
+        if (maxRegressors > 0 && k > maxRegressors) break;
     }
     
-    // Here create a new matrix of selected regressors.
+    // Here create a new matrix of selected regressors, from the candidate centers!
     Matrix *selectedRegressorMatrix = [Matrix matrixOfRows:inp->rows
                                                    columns:(int)[selectedRegressors count]];
-    int i = 0;
-    for (Matrix *r in selectedRegressors)
-    {
-        [selectedRegressorMatrix setColumn:i++ value:r];
-    }
+    __block int i = 0;
+    [selectedRegressors enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL * _Nonnull stop) {
+        [selectedRegressorMatrix setColumn:i++ value:[centers column:(int)idx]];
+    }];
     
     model.centers = selectedRegressorMatrix;
     model.widths = [Matrix matrixOfRows:model.centers.columns
@@ -216,9 +184,66 @@
     // Assign network statistics dictionary
     model.statistics[@"Error"]      = @(totalError);
     model.statistics[@"Regressors"] = @([selectedRegressors count]);
+    model.statistics[@"Candidates"] = @(M);
     
     // Clean up
     free(isSelected);
+    free(ERR);
+    free(projections);
+    free(outputDots);
+}
+
+- (void)scoreCandidates:(Matrix *)candidates
+                 output:(Matrix *)output
+             isSelected:(const bool *)isSelected
+           lastSelected:(int)lastSelected
+                 lambda:(double)lambda
+                  trace:(double)dTrace
+                    ERR:(double *)ERR
+            projections:(double *)projections
+             outputDots:(double *)outputDots
+{
+    int M = candidates->rows;    // Candidates
+    int S = candidates->columns; // Samples
+    int O = output->rows;
+    double *P = candidates->matrix;
+    const double *wl = lastSelected >= 0 ? P + lastSelected * S : NULL;
+    double wlwl = wl ? cblas_ddot(S, wl, 1, wl, 1) : 0;
+    
+    // Candidates are processed in concurrent blocks of rows
+    int threads = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+    int block = MAX(CANDIDATE_BLOCK, (M + threads - 1) / threads);
+    int blockCount = (M + block - 1) / block;
+    
+    dispatch_apply(blockCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t b) {
+        int r0 = (int)b * block;
+        int rows = MIN(block, M - r0);
+        double *Pb = P + r0 * S;
+        
+        // Orthogonalize to the last selected regressor through a rank-1
+        // update, w_i -= (wl'w_i / wl'wl) wl, leaving selected ones intact
+        if (wl)
+        {
+            double *a = projections + r0;
+            cblas_dgemv(CblasRowMajor, CblasNoTrans, rows, S, -1.0 / wlwl, Pb, S, wl, 1, 0.0, a, 1);
+            for (int i=0; i<rows; i++)
+            {
+                if (isSelected[r0 + i]) a[i] = 0;
+            }
+            cblas_dger(CblasRowMajor, rows, S, 1.0, a, 1, wl, 1, Pb, S);
+        }
+        
+        // ERR (= Error Reduction Ratio) = sum_o (w'y_o)^2 / (w'w)^2 * (w'w + lambda) / trace
+        double *G = outputDots + r0 * O;
+        cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, rows, O, S,
+                    1.0, Pb, S, output->matrix, S, 0.0, G, O);
+        for (int i=0; i<rows; i++)
+        {
+            double ww = cblas_ddot(S, Pb + i * S, 1, Pb + i * S, 1);
+            double sumg2 = cblas_ddot(O, G + i * O, 1, G + i * O, 1) / (ww * ww);
+            ERR[r0 + i] = (sumg2 * (ww + lambda)) / dTrace;
+        }
+    });
 }
 
 - (void)weightsFor:(YCRBFNet *)model input:(Matrix *)input output:(Matrix *)output
@@ -231,42 +256,178 @@
     model.weights = W;
 }
 
+- (Matrix *)candidateCentersWithInput:(Matrix *)input
+{
+    int N = input->rows;
+    int S = input->columns;
+    int M = [self.settings[@"Candidates"] intValue];
+    if (M <= 0 || M >= S) return input;
+    
+    NSString *selection = self.settings[@"Candidate Selection"];
+    int *indexes = malloc(M * sizeof(int));
+    
+    if ([selection isEqualToString:@"KMeans"])
+    {
+        // k-means++ seeding: each next center is drawn with probability
+        // proportional to its squared distance from the nearest chosen one
+        double *d2 = malloc(S * sizeof(double));
+        for (int j=0; j<S; j++) d2[j] = DBL_MAX;
+        indexes[0] = arc4random_uniform(S);
+        for (int m=1; m<=M; m++)
+        {
+            const int c = indexes[m - 1];
+            double total = 0;
+            for (int j=0; j<S; j++)
+            {
+                double sqsum = 0;
+                for (int k=0; k<N; k++)
+                {
+                    double val = input->matrix[k*S + j] - input->matrix[k*S + c];
+                    sqsum += val*val;
+                }
+                d2[j] = MIN(d2[j], sqsum);
+                total += d2[j];
+            }
+            if (m == M) break;
+            
+            double r = ((double)arc4random() / ARC4RANDOM_MAX) * total;
+            int next = -1;
+            for (int j=0; j<S; j++)
+            {
+                if (d2[j] <= 0) continue;
+                next = j;
+                r -= d2[j];
+                if (r <= 0) break;
+            }
+            // All remaining samples coincide with chosen centers
+            if (next < 0)
+            {
+                M = m;
+                break;
+            }
+            indexes[m] = next;
+        }
+        free(d2);
+    }
+    else if ([selection isEqualToString:@"Sobol"] || [selection isEqualToString:@"Halton"])
+    {
+        // Quasi-random points spanning the bounding box of the input, each
+        // replaced by the nearest sample not chosen yet
+        Matrix *mins = [input minimumsOfRows];
+        Matrix *maxs = [input maximumsOfRows];
+        Matrix *points = [selection isEqualToString:@"Sobol"] ?
+        [Matrix sobolSequenceLowerBound:mins upperBound:maxs count:M] :
+        [Matrix haltonSequenceWithLowerBound:mins upperBound:maxs count:M];
+        bool *isChosen = calloc(S, sizeof(bool));
+        for (int m=0; m<M; m++)
+        {
+            int nearest = -1;
+            double minDistance = DBL_MAX;
+            for (int j=0; j<S; j++)
+            {
+                if (isChosen[j]) continue;
+                double sqsum = 0;
+                for (int k=0; k<N; k++)
+                {
+                    double val = input->matrix[k*S + j] - points->matrix[k*M + m];
+                    sqsum += val*val;
+                }
+                if (sqsum < minDistance)
+                {
+                    nearest = j;
+                    minDistance = sqsum;
+                }
+            }
+            isChosen[nearest] = true;
+            indexes[m] = nearest;
+        }
+        free(isChosen);
+    }
+    else
+    {
+        // Partial Fisher-Yates shuffle
+        int *permutation = malloc(S * sizeof(int));
+        for (int j=0; j<S; j++) permutation[j] = j;
+        for (int m=0; m<M; m++)
+        {
+            int j = m + arc4random_uniform(S - m);
+            int t = permutation[m];
+            permutation[m] = permutation[j];
+            permutation[j] = t;
+            indexes[m] = permutation[m];
+        }
+        free(permutation);
+    }
+    
+    Matrix *centers = [Matrix matrixOfRows:N columns:M];
+    for (int m=0; m<M; m++)
+    {
+        for (int k=0; k<N; k++)
+        {
+            centers->matrix[k*M + m] = input->matrix[k*S + indexes[m]];
+        }
+    }
+    free(indexes);
+    return centers;
+}
+
 - (Matrix *)initialDesignMatrixWithInput:(Matrix *)input widths:(Matrix *)widths
 {
     NSAssert(widths.rows == input.columns, @"Widths need to have same number of rows as input matrix");
+    // With every sample as a candidate, the MxS design matrix is the SxS one
+    return [self candidateDesignMatrixWithInput:input centers:input width:widths->matrix[0]];
+}
+
+- (Matrix *)candidateDesignMatrixWithInput:(Matrix *)input
+                                   centers:(Matrix *)centers
+                                     width:(double)width
+{
     int N = input->rows;
     int S = input->columns;
+    int M = centers->columns;
+    double w2 = width * width;
+    
+    // Generate design matrix of dimensions MxS
+    Matrix *designmatrix = [Matrix matrixOfRows:M columns:S];
+    
+    // Squared norms of samples and centers, for |c - x|^2 = c'c + x'x - 2c'x
+    double *inputNorms = calloc(S, sizeof(double));
+    double *centerNorms = calloc(M, sizeof(double));
+    for (int k=0; k<N; k++)
+    {
+        const double *xk = input->matrix + k * S;
+        const double *ck = centers->matrix + k * M;
+        for (int j=0; j<S; j++) inputNorms[j] += xk[j] * xk[j];
+        for (int m=0; m<M; m++) centerNorms[m] += ck[m] * ck[m];
+    }
     
-    // Generate design matrix of dimensions SxS
-    Matrix *designmatrix = [Matrix matrixOfRows:S columns:S];
+    int threads = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+    int chunk = MAX(DESIGN_CHUNK, (M + threads - 1) / threads);
+    int chunkCount = (M + chunk - 1) / chunk;
+    
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t c) {
+        int r0 = (int)c * chunk;
+        int rows = MIN(chunk, M - r0);
+        double *D = designmatrix->matrix + r0 * S;
+        
+        // (NxM)T[r0:r0+rows] * NxS = rowsxS
+        cblas_dgemm(CblasRowMajor, CblasTrans, CblasNoTrans, rows, S, N,
+                    -2.0, centers->matrix + r0, M, input->matrix, S, 0.0, D, S);
+        for (int i=0; i<rows; i++)
+        {
+            double *Di = D + i * S;
+            double cc = centerNorms[r0 + i];
+            for (int j=0; j<S; j++)
+            {
+                Di[j] = -MAX(0, Di[j] + cc + inputNorms[j]) / w2;
+            }
+        }
+        int count = rows * S;
+        vvexp(D, D, &count);
+    });
     
-    // Fill up the design matrix, traversing first row and then column
-    dispatch_apply(S, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i)
-                   {
-                       @autoreleasepool {
-                           for (size_t j=i; j<S; j++)
-                           {
-                               if (i == j)
-                               {
-                                   designmatrix->matrix[i*(S + 1)] = 1;
-                                   continue;
-                               }
-                               double sqsum = 0;
-                               double val;
-                               for (int k=0; k<N; k++)
-                               {
-                                   val = input->matrix[k*S + i] - input->matrix[k*S + j];
-                                   sqsum += val*val;
-                               }
-                               double bfvalue = exp( - sqsum / pow(widths->matrix[j], 2));
-                               
-                               bfvalue =
-                               
-                               designmatrix->matrix[i*S + j] = bfvalue;
-                               designmatrix->matrix[j*S + i] = bfvalue;
-                           }
-                       }
-                   });
+    free(inputNorms);
+    free(centerNorms);
     return designmatrix;
 }
 
@@ -30,16 +30,9 @@
     NSAssert([self.weights count], @"Model not trained");
     NSAssert(matrix.rows == self.centers.rows, @"Input size mismatch");
     
-    // 1. Scale input
-    Matrix *ScaledInput = matrix;
-    if (self.inputTransform)
-    {
-        ScaledInput = [matrix matrixByRowWiseMapUsing:self.inputTransform];
-    }
-    
-    // 2. Calculate Basis Function Outputs
+    // 1. Calculate Basis Function Outputs, scaling input on the fly
     //    ->SxD
-    Matrix *H = [self designMatrixWithInput:ScaledInput];
+    Matrix *H = [self designMatrixWithInput:matrix transform:self.inputTransform];
     
     // 3. Augment with bias term!
     H = [H appendColumn:[Matrix matrixOfRows:H->rows columns:1 value:1.0]];
@@ -56,10 +49,16 @@
 }
 
 - (Matrix *)designMatrixWithInput:(Matrix *)input
+{
+    return [self designMatrixWithInput:input transform:nil];
+}
+
+- (Matrix *)designMatrixWithInput:(Matrix *)input transform:(Matrix *)transform
 {
     int N = input->rows;
     int S = input->columns;
     int D = self.centers->columns;
+    double *t = transform ? transform->matrix : NULL;
     
     // Generate design matrix of dimensions SxD
     Matrix *designmatrix = [Matrix matrixOfRows:S columns:D]; // -> SxD
@@ -74,7 +73,9 @@
                    double val;
                    for (int k=0; k<N; k++)
                    {
-                       val = input->matrix[k*S + i] - self->_centers->matrix[k*D + j];
+                       val = input->matrix[k*S + i];
+                       if (t) val = val * t[2*k] + t[2*k + 1];
+                       val -= self->_centers->matrix[k*D + j];
                        sqsum += val*val;
                    }
                    double bfvalue = exp( - sqsum / pow(self->_widths->matrix[j], 2));
@@ -85,6 +86,30 @@
     return designmatrix;
 }
 
+- (void)foldTransforms
+{
+    if (!self.weights || !self.outputTransform) return;
+    
+    // Output: y' = c.*y + d => W' = W diag(c), bias' = c.*bias + d
+    // Weights: (D+1)xO, last row holds the bias
+    Matrix *weights = [Matrix matrixFromMatrix:self.weights];
+    int D = weights->rows - 1;
+    int O = weights->columns;
+    double *transform = self.outputTransform->matrix;
+    for (int j=0; j<O; j++)
+    {
+        for (int i=0; i<=D; i++)
+        {
+            weights->matrix[i*O + j] *= transform[2*j];
+        }
+        weights->matrix[D*O + j] += transform[2*j + 1];
+    }
+    self.weights = weights;
+    self.outputTransform = nil;
+    
+    // The input transform is applied on the fly during activation
+}
+
 #pragma mark - Properties
 
 - (int)inputSize
@@ -22,8 +22,12 @@
 
 #import "YCCDProblem.h"
 #import "YCBinaryRBM.h"
+#import "YCEpochIterator.h"
 
 @implementation YCCDProblem
+{
+    YCEpochIterator *_epochIterator;
+}
 
 - (instancetype)initWithInputMatrix:(Matrix *)inputMatrix model:(YCBinaryRBM *)model
 {
@@ -93,9 +97,17 @@
     self.trainedModel.visibleBiases = [self visibleBiasWithParameters:parameters];
     self.trainedModel.hiddenBiases = [self hiddenBiasWithParameters:parameters];
     
-    Matrix *inputSample = self.sampleCount <= 0 ? _inputMatrix :
-    [_inputMatrix matrixBySamplingColumns:self.sampleCount
-                                        replacement:NO];
+    Matrix *inputSample = _inputMatrix;
+    if (self.sampleCount > 0 && self.sampleCount < _inputMatrix->columns)
+    {
+        // Next minibatch of the current epoch
+        if (!_epochIterator || _epochIterator.batchSize != self.sampleCount)
+        {
+            _epochIterator = [[YCEpochIterator alloc] initWithMatrices:@[_inputMatrix]
+                                                             batchSize:self.sampleCount];
+        }
+        inputSample = [[_epochIterator nextBatch] firstObject];
+    }
     
     Matrix *positiveHiddenProbs = [self.trainedModel propagateToHidden:inputSample];
     Matrix *positiveHiddenState = [self.trainedModel sampleHiddenGivenVisible:inputSample];
@@ -26,48 +26,70 @@
 
 typedef enum cacheStatus { notIncluded, included } cacheStatus;
 
+/**
+ A kernel cache for SMO, holding full kernel rows K(i, :) over the whole
+ dataset, in the manner of LIBSVM. Rows are stored in one contiguous
+ buffer, sized by a memory budget, and are evicted in least recently used
+ order in constant time. Kernel diagonal values are cached permanently.
+ 
+ Reads (rowForIndex:, queryI:j:, and getI:j:tickle: without tickling) do
+ not modify the cache, and may run concurrently with each other without
+ locking; insertions and tickling must not run concurrently with reads.
+ */
 @interface YCSMOCache : NSObject
 
-- (instancetype)initWithDatasetSize:(NSUInteger)datasetSize cacheSize:(NSUInteger)cacheSize;
-
-- (cacheStatus)queryI:(NSUInteger)i j:(NSUInteger)j;
-
-- (double)getI:(NSUInteger)i j:(NSUInteger)j tickle:(BOOL)tickle;
+/**
+ Initializes a cache for a dataset of |datasetSize| samples, holding as
+ many rows as fit in |memoryBudget| bytes (at least two).
+ */
+- (instancetype)initWithDatasetSize:(NSUInteger)datasetSize memoryBudget:(NSUInteger)memoryBudget;
 
-- (void)setI:(NSUInteger)i j:(NSUInteger)j value:(double)value;
+/**
+ Returns the cached kernel row of sample |i| (datasetSize values), or
+ NULL if it is not cached.
+ */
+- (const double *)rowForIndex:(NSUInteger)i;
 
-///@name Properties
+/**
+ Returns a buffer for the kernel row of sample |i|, evicting the least
+ recently used row if required, and marks the row as most recently used.
+ The caller should fill the returned buffer with all datasetSize values.
+ */
+- (double *)insertRowForIndex:(NSUInteger)i;
 
 /**
- An array containing indexes in cache of each example in the dataset
- i.e. index[i] == index in cache of example i
+ Marks the row of sample |i|, if cached, as most recently used.
  */
-@property NSUInteger *index;
+- (void)tickleRowForIndex:(NSUInteger)i;
 
 /**
- An array containing all indexes in dataset for each cache element
- i.e. inverseIndex[n] == index in dataset of cache element n
+ Returns whether K(i, j) is available, either on the diagonal or in the
+ row of sample i or j.
  */
-@property NSUInteger *inverseIndex;
+- (cacheStatus)queryI:(NSUInteger)i j:(NSUInteger)j;
+
+- (double)getI:(NSUInteger)i j:(NSUInteger)j tickle:(BOOL)tickle;
 
 /**
- The cache values, MxM
+ Stores a diagonal kernel value K(i, i).
  */
-@property Matrix *values;
+- (void)setDiagonalValue:(double)value index:(NSUInteger)i;
+
+///@name Properties
 
 /**
- The LRU nodes
+ The number of samples in the dataset, i.e. the length of each row.
  */
-@property LNode *nodes; // LRU nodes
+@property (readonly) NSUInteger datasetSize;
 
 /**
- The order of LRU indexes
+ The maximum number of rows held by the receiver.
  */
-@property YCLinkedList *order; // LRU order
+@property (readonly) NSUInteger rowCapacity;
 
 /**
  The permanent diagonal kernel cache
  */
-@property Matrix *diagonalCache;
+@property (readonly) Matrix *diagonalCache;
 
 @end
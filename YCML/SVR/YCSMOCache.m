@@ -23,201 +23,114 @@
 #import "YCSMOCache.h"
 @import YCMatrix;
 
-typedef struct node
-{
-    struct LIST_NODE *next, *prev;
-    void *data;
-} node;
+static const NSUInteger notFound = NSUIntegerMax;
 
 @implementation YCSMOCache
 {
-    NSUInteger _datasetSize;
-    NSUInteger _cacheSize;
+    NSUInteger *_index;         // Slot of each sample's row, or notFound
+    NSUInteger *_inverseIndex;  // Sample of each slot, or notFound
+    double *_rows;              // rowCapacity x datasetSize
+    LNode *_nodes;              // One LRU node per slot
+    YCLinkedList *_order;       // LRU order, least recently used at the head
 }
 
-static NSUInteger notFound = NSUIntegerMax;
-
-- (instancetype)initWithDatasetSize:(NSUInteger)datasetSize cacheSize:(NSUInteger)cacheSize
+- (instancetype)initWithDatasetSize:(NSUInteger)datasetSize memoryBudget:(NSUInteger)memoryBudget
 {
     self = [super init];
     if (self)
     {
-        self.index = malloc(sizeof(NSUInteger) * datasetSize);
-        self.inverseIndex = malloc(sizeof(NSUInteger) * cacheSize);
-        self.values = [Matrix matrixOfRows:(int)cacheSize columns:(int)cacheSize value:-DBL_MAX];
-        self.nodes = malloc(sizeof(LNode) * cacheSize);
-        self.order = [[YCLinkedList alloc] init];
+        _datasetSize   = datasetSize;
+        _rowCapacity   = MAX(2, memoryBudget / (MAX(1, datasetSize) * sizeof(double)));
+        _rowCapacity   = MIN(_rowCapacity, MAX(2, datasetSize));
+        _index         = malloc(datasetSize * sizeof(NSUInteger));
+        _inverseIndex  = malloc(_rowCapacity * sizeof(NSUInteger));
+        _rows          = malloc(_rowCapacity * datasetSize * sizeof(double));
+        _nodes         = malloc(_rowCapacity * sizeof(LNode));
+        _order         = [[YCLinkedList alloc] init];
+        _diagonalCache = [Matrix matrixOfRows:(int)datasetSize columns:1 value:-DBL_MAX];
         
-        for (int i = 0; i < datasetSize; i++)
+        for (NSUInteger i=0; i<datasetSize; i++)
         {
-            self.index[i] = notFound;
+            _index[i] = notFound;
         }
-        
-        
-        for (int i = 0; i < cacheSize; i++)
+        for (NSUInteger n=0; n<_rowCapacity; n++)
         {
-            self.inverseIndex[i] = notFound;
-            
-            LNode *node = &self.nodes[i];
-            node->index = i;
-            
-            [self.order pushTail:&self.nodes[i]];
+            _inverseIndex[n] = notFound;
+            _nodes[n].index = n;
+            [_order pushTail:&_nodes[n]];
         }
-        
-        self.diagonalCache = [Matrix matrixOfRows:(int)datasetSize columns:1 value:-DBL_MAX];
-        
-        _datasetSize = datasetSize;
-        _cacheSize = cacheSize;
     }
     return self;
 }
 
-- (cacheStatus)queryI:(NSUInteger)i j:(NSUInteger)j
+- (const double *)rowForIndex:(NSUInteger)i
 {
-    if (i == j)
-    {
-        if ([self.diagonalCache i:(int)i j:0] == -DBL_MAX)
-        {
-            return notIncluded;
-        }
-        return included;
-    }
-    
-    NSUInteger ci = self.index[i];
-    NSUInteger cj = self.index[j];
-    
-    if (cj > ci)
+    NSUInteger slot = _index[i];
+    return slot == notFound ? NULL : _rows + slot * _datasetSize;
+}
+
+- (double *)insertRowForIndex:(NSUInteger)i
+{
+    NSUInteger slot = _index[i];
+    if (slot == notFound)
     {
-        NSUInteger swap = cj;
-        cj = ci;
-        ci = swap;
+        // Reuse the least recently used slot; only its owner is invalidated
+        LNode *node = [_order popHead];
+        slot = node->index;
+        if (_inverseIndex[slot] != notFound) _index[_inverseIndex[slot]] = notFound;
+        _index[i] = slot;
+        _inverseIndex[slot] = i;
+        [_order pushTail:node];
     }
-    
-    if (ci == notFound || cj == notFound || [self.values i:(int)ci j:(int)cj] == -DBL_MAX)
+    else
     {
-        return notIncluded;
+        [self tickleRowForIndex:i];
     }
+    return _rows + slot * _datasetSize;
+}
 
-    return included;
+- (void)tickleRowForIndex:(NSUInteger)i
+{
+    NSUInteger slot = _index[i];
+    if (slot == notFound || _order.tailNode == &_nodes[slot]) return;
+    [_order pop:&_nodes[slot]];
+    [_order pushTail:&_nodes[slot]];
 }
 
-- (double)getI:(NSUInteger)i j:(NSUInteger)j tickle:(BOOL)tickle
+- (cacheStatus)queryI:(NSUInteger)i j:(NSUInteger)j
 {
     if (i == j)
     {
-        return [self.diagonalCache i:(int)i j:0];
+        return _diagonalCache->matrix[i] == -DBL_MAX ? notIncluded : included;
     }
-    
-    NSUInteger ci = self.index[i];
-    NSUInteger cj = self.index[j];
-    
-    if (cj > ci)
-    {
-        NSUInteger swap = cj;
-        cj = ci;
-        ci = swap;
-    }
-    
-    NSAssert(ci != notFound && cj != notFound &&
-             [self.values i:(int)ci j:(int)cj] != -DBL_MAX, @"Invalid cache request");
-    
-    // Here also check if node->next exists, if not it is already last.
-    if (tickle)
-    {
-        [self.order pop:&self.nodes[ci]];
-        [self.order pushTail:&self.nodes[ci]];
-        [self.order pop:&self.nodes[cj]];
-        [self.order pushTail:&self.nodes[cj]];
-    }
-    return [self.values i:(int)ci j:(int)cj];
+    return (_index[i] != notFound || _index[j] != notFound) ? included : notIncluded;
 }
 
-- (void)setI:(NSUInteger)i j:(NSUInteger)j value:(double)value
+- (double)getI:(NSUInteger)i j:(NSUInteger)j tickle:(BOOL)tickle
 {
     if (i == j)
     {
-        [self.diagonalCache i:(int)i j:0 set:value];
-        return;
-    }
-    
-    NSUInteger ci, cj;
-    
-    if (self.index[i] == notFound)
-    {
-        // index[i] does not exist in the cache
-        LNode *node = [self.order popHead];
-        
-        // ci is the offset from inverseindex pointed by node->obj
-        ci = node->index;
-        
-        // ci is now the location in the cache that is to be overwritten (LRU)
-        for (int k = 0; k < ci; k++)
-        {
-            [self.values i:(int)ci j:k set:-DBL_MAX];
-        }
-        for (int k = (int)ci; k < _cacheSize; k++)
-        {
-            [self.values i:k j:(int)ci set:-DBL_MAX];
-        }
-        
-        if (self.inverseIndex[ci] != notFound) self.index[self.inverseIndex[ci]] = notFound;
-        
-        self.index[i] = ci;
-        self.inverseIndex[ci] = i;
-        [self.order pushTail:node];
-    }
-    else
-    {
-        ci = self.index[i];
-        [self.order pop:&self.nodes[ci]];
-        [self.order pushTail:&self.nodes[ci]];
-    }
-    
-    if (self.index[j] == notFound)
-    {
-        // index[j] does not exist in the cache
-        LNode *node = [self.order popHead];
-        
-        cj = node->index;
-        
-        // cj is now the location in the cache that is to be overwritten (LRU)
-        for (int k = 0; k < cj; k++)
-        {
-            [self.values i:(int)cj j:k set:-DBL_MAX];
-        }
-        for (int k = (int)cj; k < _cacheSize; k++)
-        {
-            [self.values i:k j:(int)cj set:-DBL_MAX];
-        }
-        
-        if (self.inverseIndex[cj] != notFound) self.index[self.inverseIndex[cj]] = notFound;
-        
-        self.index[j] = cj;
-        self.inverseIndex[cj] = j;
-        [self.order pushTail:node];
-    }
-    else
-    {
-        cj = self.index[j];
-        [self.order pop:&self.nodes[cj]];
-        [self.order pushTail:&self.nodes[cj]];
-    }
-    
-    // ci and cj now refer to the cache entries that should be written
-    
-    if (cj > ci)
-    {
-        NSUInteger swap = cj;
-        cj = ci;
-        ci = swap;
+        return _diagonalCache->matrix[i];
     }
     
-    [self.values i:(int)ci j:(int)cj set:value];
+    // The kernel is symmetric, so either row will do
+    NSUInteger row = _index[i] != notFound ? i : j;
+    NSAssert(_index[row] != notFound, @"Invalid cache request");
+    if (tickle) [self tickleRowForIndex:row];
+    return _rows[_index[row] * _datasetSize + (row == i ? j : i)];
+}
+
+- (void)setDiagonalValue:(double)value index:(NSUInteger)i
+{
+    _diagonalCache->matrix[i] = value;
 }
 
 - (void)dealloc
 {
-    free(self.nodes);
+    free(_index);
+    free(_inverseIndex);
+    free(_rows);
+    free(_nodes);
 }
 
 @end
@@ -23,6 +23,10 @@
 #import "YCSupervisedTrainer.h"
 @class YCSVR, YCSMOCache, Matrix;
 
+// Minimum number of elements per thread, for concurrent updates of output
+// and gradient vectors after each SMO step
+#define UPDATE_CHUNK 4096
+
 @interface YCSMORegressionTrainer : YCSupervisedTrainer
 
 - (double)outputForModel:(YCSVR *)model
@@ -57,6 +61,56 @@ lastModified:(Matrix *)lastModified
            C:(double)C
  tickleCache:(BOOL)tickle;
 
+/**
+ Assigns the kernel described by the receiver's settings to |model|, if
+ the model does not already have one.
+ */
+- (void)prepareKernelForModel:(YCSVR *)model;
+
+/**
+ Brings the outputs of all samples up to date after a successful step,
+ through o += Δλ_u K(u, :) + Δλ_v K(v, :). The update is split in chunks
+ that are processed concurrently, and all samples are then marked as
+ current in |lastModified|.
+ */
+- (void)updateOutputs:(Matrix *)previousOutputs
+         lastModified:(Matrix *)lastModified
+                input:(Matrix *)input
+                model:(YCSVR *)model;
+
+/**
+ Sets up the kernel row cache (unless disabled by the settings) and the
+ scratch buffers used for computing kernel rows of |input|. Depending on
+ the "Kernel Matrix" setting, the full kernel matrix is precomputed
+ ("Precomputed"), rows are computed on demand and kept in an LRU cache
+ ("Cached"), or the former is chosen when the matrix fits within the
+ "Cache Memory" budget ("Auto"). The legacy "Cache Size" setting, a count of
+ cached samples, takes precedence when present, as a budget of that many
+ kernel rows.
+ */
+- (void)prepareKernelRowsForInput:(Matrix *)input model:(YCSVR *)model;
+
+/**
+ Releases the cache and buffers set up by prepareKernelRowsForInput:model:.
+ */
+- (void)clearKernelRows;
+
+/**
+ Stores the kernel matrix mode ("Precomputed", "Cached" or "None") and
+ the memory used for kernel rows, in bytes, in the statistics of |model|,
+ under "Kernel Matrix" and "Kernel Memory".
+ */
+- (void)storeKernelStatisticsInModel:(YCSVR *)model;
+
+/**
+ Returns the kernel row of sample |a| against all samples of |input|,
+ either from the cache or computed on demand. When the cache is disabled,
+ the row is computed into one of two scratch buffers, selected by |slot|,
+ so that the rows of a pair of samples may be used together.
+ */
+- (const double *)kernelRowForIndex:(NSUInteger)a slot:(int)slot
+                              input:(Matrix *)input model:(YCSVR *)model;
+
 - (double)kernelValueForA:(NSUInteger)a B:(NSUInteger)b input:(Matrix *)input
                     model:(YCSVR *)model tickle:(BOOL)tickle replace:(BOOL)replace;
 
@@ -31,6 +31,10 @@
 #define EPS 1E-8
 #define TOL 1E-3
 
+// Number of kernel rows per block, when precomputing the kernel matrix into
+// cache rows that are not contiguous
+#define GRAM_BLOCK 64
+
 #import "YCSMORegressionTrainer.h"
 #import "YCSVR.h"
 #import "YCModelKernel.h"
@@ -38,6 +42,7 @@
 #import "YCRBFKernel.h"
 #import "YCSMOCache.h"
 @import YCMatrix;
+@import Accelerate;
 
 @interface NSMutableOrderedSet (Shuffling)
 
@@ -49,6 +54,8 @@
 {
     YCSMOCache *_cache;
     Matrix *_transposedInput;
+    NSMutableData *_kernelRow;
+    NSString *_kernelMatrixMode;
     NSUInteger _globalChange;
     NSUInteger _iul;
     NSUInteger _ivl;
@@ -70,7 +77,8 @@
         self.settings[@"Kernel"]            = @"Linear"; // Linear, RBF
         self.settings[@"Beta"]              = @1.0; // For RBF kernels
         self.settings[@"Disable Cache"]     = @NO;
-        self.settings[@"Cache Size"]        = @300;
+        self.settings[@"Cache Memory"]      = @100; // MB, for kernel rows
+        self.settings[@"Kernel Matrix"]     = @"Auto"; // Auto, Precomputed, Cached
     }
     return self;
 }
@@ -99,32 +107,13 @@
     int changed             = 0;
     BOOL examineAll         = YES;
     
-    _transposedInput = [scaledInput matrixByTransposing];
-    if ([self.settings[@"Disable Cache"] boolValue])
-    {
-        NSUInteger cacheSize = MIN([self.settings[@"Cache Size"] unsignedIntValue],
-                                   scaledInput.columns);
-        _cache = [[YCSMOCache alloc] initWithDatasetSize:scaledInput.columns
-                                               cacheSize:cacheSize];
-    }
+    [self prepareKernelForModel:model];
+    [self prepareKernelRowsForInput:scaledInput model:model];
     
     Matrix *lambdas = [Matrix matrixOfRows:1 columns:N];
     Matrix *previousOutputs = [Matrix matrixOfRows:1 columns:N value:0];
     Matrix *lastModified = [Matrix matrixOfRows:1 columns:N value:_globalChange];
     
-    if (!model.kernel)
-    {
-        if ([self.settings[@"Kernel"] isEqualToString:@"RBF"])
-        {
-            model.kernel = [[YCRBFKernel alloc] init];
-            model.kernel.properties[@"Beta"] = self.settings[@"Beta"];
-        }
-        else
-        {
-            model.kernel = [[YCLinearKernel alloc] init];
-        }
-    }
-    
     NSMutableOrderedSet *order = [NSMutableOrderedSet orderedSet];
     for (int i = 0; i<N; i++)
     {
@@ -150,6 +139,8 @@
                 {
                     changed++;
                     _globalChange++;
+                    [self updateOutputs:previousOutputs lastModified:lastModified
+                                  input:scaledInput model:model];
                 }
             }
         }
@@ -168,6 +159,8 @@
                     {
                         changed++;
                         _globalChange++;
+                        [self updateOutputs:previousOutputs lastModified:lastModified
+                                      input:scaledInput model:model];
                     }
                 }
             }
@@ -211,10 +204,11 @@
     model.inputTransform = inputTransform;
     model.outputTransform = invOutTransform;
     
+    [self storeKernelStatisticsInModel:model];
+    
     // Cleanup
-    _cache = nil;
+    [self clearKernelRows];
     _globalChange = 0;
-    _transposedInput = nil;
     
     _iul = 0;
     _ivl = 0;
@@ -222,6 +216,22 @@
     _dvl = 0;
 }
 
+- (void)prepareKernelForModel:(YCSVR *)model
+{
+    if (!model.kernel)
+    {
+        if ([self.settings[@"Kernel"] isEqualToString:@"RBF"])
+        {
+            model.kernel = [[YCRBFKernel alloc] init];
+            model.kernel.properties[@"Beta"] = self.settings[@"Beta"];
+        }
+        else
+        {
+            model.kernel = [[YCLinearKernel alloc] init];
+        }
+    }
+}
+
 - (BOOL)examine:(int)idx1
           model:(YCSVR *)model
           input:(Matrix *)input
@@ -418,6 +428,45 @@ lastModified:(Matrix *)lastModified
     return YES;
 }
 
+- (void)updateOutputs:(Matrix *)previousOutputs
+         lastModified:(Matrix *)lastModified
+                input:(Matrix *)input
+                model:(YCSVR *)model
+{
+    // After a successful step only the multipliers of u and v have changed,
+    // hence o_k += Δλ_u K(u, k) + Δλ_v K(v, k) brings every output up to date
+    int S = input->columns;
+    const double *ku = [self kernelRowForIndex:_iul slot:0 input:input model:model];
+    const double *kv = [self kernelRowForIndex:_ivl slot:1 input:input model:model];
+    double *o = previousOutputs->matrix;
+    double du = _dul;
+    double dv = _dvl;
+    
+    int threads = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+    int chunk = MAX(UPDATE_CHUNK, (S + threads - 1) / threads);
+    int chunkCount = (S + chunk - 1) / chunk;
+    
+    void (^update)(size_t) = ^(size_t c) {
+        int start = (int)c * chunk;
+        int length = MIN(chunk, S - start);
+        cblas_daxpy(length, du, ku + start, 1, o + start, 1);
+        cblas_daxpy(length, dv, kv + start, 1, o + start, 1);
+    };
+    
+    if (chunkCount > 1)
+    {
+        dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0),
+                       update);
+    }
+    else
+    {
+        update(0);
+    }
+    
+    double stamp = _globalChange;
+    vDSP_vfillD(&stamp, lastModified->matrix, 1, S);
+}
+
 - (double)errorForModel:(YCSVR *)model
                   input:(Matrix *)input
                  target:(Matrix *)output
@@ -451,31 +500,17 @@ lastModified:(Matrix *)lastModified
         // 12% decrease in CPU time (p<0.001)
         output = [previousOutputs i:0 j:index];
     }
-    else if (lastModified && [lastModified i:0 j:index] == _globalChange - 1)
-    {
-        // 70% decrease in CPU time (p<0.001)
-        double po = [previousOutputs i:0 j:index];
-        double ku = [self kernelValueForA:_iul B:index input:input model:model
-                                 tickle:tickle replace:tickle];
-        double kv = [self kernelValueForA:_ivl B:index input:input model:model
-                                 tickle:tickle replace:tickle];
-        output = po + ku * _dul + kv * _dvl;
-        
-        [previousOutputs i:0 j:index set:output];
-        [lastModified i:0 j:index set:_globalChange];
-    }
     else
     {
-        Matrix *k = [model.kernel kernelValueForA:input b:[input column:index]];
-        
-        double o = 0.0;
-        
-        for (int i=0, n=(int)k.count; i<n; i++)
+        // Full recalculation, from the cached kernel row if available
+        const double *k = [self.cache rowForIndex:index];
+        if (!k)
         {
-            double l = [lambdas i:0 j:i];
-            if (l == 0) continue;
-            o += l * [k i:i j:0];
+            double *row = [self kernelRowBuffer:input slot:0];
+            [self fillKernelRow:row index:index input:input model:model];
+            k = row;
         }
+        double o = cblas_ddot(input->columns, lambdas->matrix, 1, k, 1);
         output = o;
         
         [previousOutputs i:0 j:index set:o];
@@ -489,31 +524,172 @@ lastModified:(Matrix *)lastModified
 - (double)kernelValueForA:(NSUInteger)a B:(NSUInteger)b input:(Matrix *)input
                     model:(YCSVR *)model tickle:(BOOL)tickle replace:(BOOL)replace
 {
-    if (self.cache && [self.cache queryI:a j:b] == included)
+    YCSMOCache *cache = self.cache;
+    if (cache && [cache queryI:a j:b] == included)
+    {
+        return [cache getI:a j:b tickle:tickle];
+    }
+    
+    // Off-diagonal misses bring in the whole row of a, as SMO goes on to
+    // request kernel values of the same sample against many others
+    if (cache && replace && a != b)
     {
-        return [self.cache getI:a j:b tickle:tickle];
+        double *row = [cache insertRowForIndex:a];
+        [self fillKernelRow:row index:a input:input model:model];
+        return row[b];
     }
     
-    Matrix *aVector, *bVector;
+    double val;
     if (_transposedInput)
     {
-        aVector = [_transposedInput rowReferenceVector:(int)a];
-        bVector = [_transposedInput rowReferenceVector:(int)b];
+        // Rows of the transposed input hold each sample contiguously
+        int N = input->rows;
+        val = [model.kernel kernelValueForVector:_transposedInput->matrix + a * N
+                                          vector:_transposedInput->matrix + b * N
+                                          length:N];
     }
     else
     {
-        aVector = [input column:(int)a];
-        bVector = [input column:(int)b];
+        val = [[model.kernel kernelValueForA:[input column:(int)a] b:[input column:(int)b]] i:0 j:0];
     }
-    
-    double val = [[model.kernel kernelValueForA:aVector b:bVector] i:0 j:0];
-    if (self.cache && replace)
+    if (cache && replace)
     {
-        [self.cache setI:a j:b value:val];
+        [cache setDiagonalValue:val index:a];
     }
     return val;
 }
 
+- (void)fillKernelRow:(double *)row index:(NSUInteger)a input:(Matrix *)input model:(YCSVR *)model
+{
+    // The transposed input holds each sample contiguously
+    if (_transposedInput)
+    {
+        [model.kernel kernelValuesForA:input vector:_transposedInput->matrix + a * input->rows into:row];
+    }
+    else
+    {
+        Matrix *vector = [input column:(int)a];
+        [model.kernel kernelValuesForA:input vector:vector->matrix into:row];
+    }
+}
+
+- (void)prepareKernelRowsForInput:(Matrix *)input model:(YCSVR *)model
+{
+    int S = input->columns;
+    _transposedInput = [input matrixByTransposing];
+    _kernelRow = [NSMutableData dataWithLength:2 * S * sizeof(double)];
+    _cache = nil;
+    _kernelMatrixMode = @"None";
+    if ([self.settings[@"Disable Cache"] boolValue]) return;
+    
+    // The legacy "Cache Size" setting counts cached samples, i.e. kernel rows
+    NSNumber *legacySize = self.settings[@"Cache Size"];
+    NSUInteger budget = legacySize ?
+    MIN([legacySize unsignedIntegerValue], (NSUInteger)S) * S * sizeof(double) :
+    [self.settings[@"Cache Memory"] doubleValue] * 1024 * 1024;
+    NSUInteger gramSize = (NSUInteger)S * S * sizeof(double);
+    NSString *mode = self.settings[@"Kernel Matrix"];
+    BOOL precompute = [mode isEqualToString:@"Precomputed"] ||
+                      ([mode isEqualToString:@"Auto"] && gramSize <= budget);
+    
+    if (precompute)
+    {
+        // A cache that holds every row, filled up front
+        _cache = [[YCSMOCache alloc] initWithDatasetSize:S memoryBudget:gramSize];
+        [self fillKernelMatrixForInput:input model:model];
+        _kernelMatrixMode = @"Precomputed";
+    }
+    else
+    {
+        _cache = [[YCSMOCache alloc] initWithDatasetSize:S memoryBudget:budget];
+        _kernelMatrixMode = @"Cached";
+    }
+}
+
+- (void)fillKernelMatrixForInput:(Matrix *)input model:(YCSVR *)model
+{
+    int S = input->columns;
+    double **rows = malloc(S * sizeof(double *));
+    BOOL contiguous = YES;
+    for (int i=0; i<S; i++)
+    {
+        rows[i] = [_cache insertRowForIndex:i];
+        contiguous = contiguous && rows[i] == rows[0] + (size_t)i * S;
+    }
+    
+    // The kernel matrix is evaluated through the tiled, concurrent path of
+    // the kernel; straight into the cache if its rows are laid out in order,
+    // otherwise in blocks of rows through a scratch buffer
+    YCModelKernel *kernel = model.kernel;
+    if (contiguous)
+    {
+        [kernel kernelValueForA:input b:input into:rows[0]];
+    }
+    else
+    {
+        double *scratch = malloc(GRAM_BLOCK * S * sizeof(double));
+        for (int r0=0; r0<S; r0+=GRAM_BLOCK)
+        {
+            int n = MIN(GRAM_BLOCK, S - r0);
+            [kernel kernelValueForA:[input matrixWithColumnsInRange:NSMakeRange(r0, n)]
+                                  b:input
+                               into:scratch];
+            for (int i=0; i<n; i++)
+            {
+                memcpy(rows[r0 + i], scratch + i * S, S * sizeof(double));
+            }
+        }
+        free(scratch);
+    }
+    
+    free(rows);
+}
+
+- (void)clearKernelRows
+{
+    _cache = nil;
+    _transposedInput = nil;
+    _kernelRow = nil;
+}
+
+- (void)storeKernelStatisticsInModel:(YCSVR *)model
+{
+    NSUInteger memory = _cache.rowCapacity * _cache.datasetSize * sizeof(double);
+    model.statistics[@"Kernel Matrix"] = _kernelMatrixMode ? _kernelMatrixMode : @"None";
+    model.statistics[@"Kernel Memory"] = @(memory);
+}
+
+- (const double *)kernelRowForIndex:(NSUInteger)a slot:(int)slot
+                              input:(Matrix *)input model:(YCSVR *)model
+{
+    YCSMOCache *cache = self.cache;
+    if (cache)
+    {
+        const double *cached = [cache rowForIndex:a];
+        if (cached)
+        {
+            [cache tickleRowForIndex:a];
+            return cached;
+        }
+        double *row = [cache insertRowForIndex:a];
+        [self fillKernelRow:row index:a input:input model:model];
+        return row;
+    }
+    double *row = [self kernelRowBuffer:input slot:slot];
+    [self fillKernelRow:row index:a input:input model:model];
+    return row;
+}
+
+- (double *)kernelRowBuffer:(Matrix *)input slot:(int)slot
+{
+    // Two scratch rows, for the pair of samples of a step
+    if (!_kernelRow || _kernelRow.length < 2 * input->columns * sizeof(double))
+    {
+        _kernelRow = [NSMutableData dataWithLength:2 * input->columns * sizeof(double)];
+    }
+    return (double *)_kernelRow.mutableBytes + slot * input->columns;
+}
+
 @end
 
 @implementation NSMutableOrderedSet (Shuffling)
@@ -0,0 +1,64 @@
+//
+//  YCSVR+Reduction.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCSVR.h"
+@class Matrix;
+
+/**
+ Post-training reduction of the support vector set. The decision function
+ of the receiver is approximated with a subset of its support vectors,
+ selected through orthogonal forward selection (as in YCOLSTrainer) on
+ the kernel values at a set of evaluation points, after which the
+ multipliers of the selected vectors are refitted by least squares. The
+ bias and transforms of the receiver are kept. At least one vector is
+ always kept, so that the reduced model remains usable. Models with a
+ linear kernel are reduced exactly to a single vector.
+ 
+ The reduced model's statistics hold the number of remaining vectors
+ under "Support Vectors", and the RMS deviation from the decision function
+ of the receiver, in output units, under "Reduction Error".
+ */
+@interface YCSVR (Reduction)
+
+/**
+ Returns a model using the fewest support vectors found that approximate
+ the receiver's output at its support vectors with an RMS error of at
+ most |tolerance|.
+ 
+ @param tolerance The maximum RMS error, in output units.
+ 
+ @return The reduced model.
+ */
+- (YCSVR *)reducedModelWithTolerance:(double)tolerance;
+
+/**
+ As reducedModelWithTolerance:, with the error evaluated at the samples
+ of |input| instead.
+ 
+ @param tolerance The maximum RMS error, in output units.
+ @param input     The evaluation samples (NxM), in input units.
+ 
+ @return The reduced model.
+ */
+- (YCSVR *)reducedModelWithTolerance:(double)tolerance inputMatrix:(Matrix *)input;
+
+@end
@@ -0,0 +1,173 @@
+//
+//  YCSVR+Reduction.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+// N: Size of input
+// V: Support Vector count
+// M: Number of evaluation samples
+// R: Number of retained vectors
+
+#import "YCSVR+Reduction.h"
+#import "YCModelKernel.h"
+#import "YCLinearKernel.h"
+@import YCMatrix;
+@import Accelerate;
+
+@implementation YCSVR (Reduction)
+
+- (YCSVR *)reducedModelWithTolerance:(double)tolerance
+{
+    return [self reducedModelWithTolerance:tolerance inputMatrix:nil];
+}
+
+- (YCSVR *)reducedModelWithTolerance:(double)tolerance inputMatrix:(Matrix *)input
+{
+    NSAssert([self.sv count], @"Model not trained");
+    
+    YCSVR *reduced = [YCSVR model];
+    reduced.statistics       = [self.statistics mutableCopy];
+    reduced.trainingSettings = [self.trainingSettings mutableCopy];
+    reduced.kernel           = self.kernel;
+    reduced.b                = self.b;
+    reduced.inputTransform   = self.inputTransform;
+    reduced.outputTransform  = self.outputTransform;
+    
+    // The linear decision function is w'x + b, with w = sv * lambda'
+    if ([self.kernel isMemberOfClass:[YCLinearKernel class]])
+    {
+        reduced.sv = [self.sv matrixByMultiplyingWithRight:[self.lambda matrixByTransposing]]; // Nx1
+        reduced.lambda = [Matrix matrixOfRows:1 columns:1 value:1];
+        reduced.statistics[@"Support Vectors"] = @1;
+        reduced.statistics[@"Reduction Error"] = @0;
+        return reduced;
+    }
+    
+    // Errors are measured before the output transform, y = c*f + d
+    double outputScale = self.outputTransform ? ABS(self.outputTransform->matrix[0]) : 1.0;
+    double internalTolerance = tolerance / outputScale;
+    
+    Matrix *points = self.sv;
+    if (input)
+    {
+        points = self.inputTransform ? [input matrixByRowWiseMapUsing:self.inputTransform] : input;
+    }
+    
+    int V = self.sv->columns;
+    int M = points->columns;
+    
+    // Regressors are the kernel rows of each support vector (VxM), and the
+    // target is the decision function without the bias (1xM)
+    Matrix *K = [self.kernel kernelValueForA:self.sv b:points];
+    Matrix *target = [self.lambda matrixByMultiplyingWithRight:K];
+    
+    // Forward selection, through modified Gram-Schmidt orthogonalization of
+    // the remaining regressors against each selected one
+    Matrix *W = [Matrix matrixFromMatrix:K];
+    Matrix *residual = [Matrix matrixFromMatrix:target];
+    double *w = W->matrix;
+    double *e = residual->matrix;
+    double *projections = malloc(V * sizeof(double));
+    double *q = malloc(M * sizeof(double));
+    BOOL *isSelected = calloc(V, sizeof(BOOL));
+    NSMutableIndexSet *selected = [NSMutableIndexSet indexSet];
+    
+    // At least one vector is selected, as YCSVR requires support vectors
+    double error = sqrt(cblas_ddot(M, e, 1, e, 1) / M);
+    while ((error > internalTolerance || selected.count == 0) && selected.count < V)
+    {
+        // Select the regressor that removes the most of the residual
+        int best = -1;
+        double bestReduction = 0;
+        for (int i=0; i<V; i++)
+        {
+            if (isSelected[i]) continue;
+            double *wi = w + i * M;
+            double ww = cblas_ddot(M, wi, 1, wi, 1);
+            if (ww <= 1E-12) continue;
+            double we = cblas_ddot(M, wi, 1, e, 1);
+            double reduction = we * we / ww;
+            if (reduction > bestReduction)
+            {
+                bestReduction = reduction;
+                best = i;
+            }
+        }
+        if (best < 0) break;
+        
+        isSelected[best] = YES;
+        [selected addIndex:best];
+        
+        // q = w_best / |w_best|; e -= (q'e) q; W -= (W q) q' for the rest
+        double *wb = w + best * M;
+        double norm = 1.0 / cblas_dnrm2(M, wb, 1);
+        vDSP_vsmulD(wb, 1, &norm, q, 1, M);
+        cblas_daxpy(M, -cblas_ddot(M, q, 1, e, 1), q, 1, e, 1);
+        cblas_dgemv(CblasRowMajor, CblasNoTrans, V, M, 1.0, w, M, q, 1, 0.0, projections, 1);
+        for (int i=0; i<V; i++)
+        {
+            if (isSelected[i]) projections[i] = 0;
+        }
+        cblas_dger(CblasRowMajor, V, M, -1.0, projections, 1, q, 1, w, M);
+        
+        error = sqrt(cblas_ddot(M, e, 1, e, 1) / M);
+    }
+    
+    free(projections);
+    free(q);
+    free(isSelected);
+    
+    // No regressor qualified (e.g. vanishing kernel values); keep the vector
+    // with the largest multiplier
+    if (selected.count == 0)
+    {
+        vDSP_Length largest;
+        double magnitude;
+        vDSP_maxmgviD(self.lambda->matrix, 1, &magnitude, &largest, V);
+        [selected addIndex:largest];
+    }
+    
+    // Refitting the multipliers of the selected vectors, target = lambda' * Ksel
+    int R = (int)selected.count;
+    Matrix *sv = [Matrix matrixOfRows:self.sv->rows columns:R];
+    Matrix *Ksel = [Matrix matrixOfRows:R columns:M];
+    __block int r = 0;
+    [selected enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL * _Nonnull stop) {
+        [sv setColumn:r value:[self.sv column:(int)idx]];
+        memcpy(Ksel->matrix + r * M, K->matrix + idx * M, M * sizeof(double));
+        r++;
+    }];
+    
+    Matrix *KselT = [Ksel matrixByTransposing]; // MxR
+    Matrix *lambda = [[[KselT pseudoInverse] matrixByMultiplyingWithRight:
+                       [target matrixByTransposing]] matrixByTransposing];
+    
+    Matrix *approximation = [lambda matrixByMultiplyingWithRight:Ksel];
+    Matrix *difference = [approximation matrixBySubtracting:target];
+    double rms = sqrt([difference dotWith:difference] / M);
+    
+    reduced.sv = sv;
+    reduced.lambda = lambda;
+    reduced.statistics[@"Support Vectors"] = @(R);
+    reduced.statistics[@"Reduction Error"] = @(rms * outputScale);
+    return reduced;
+}
+
+@end
@@ -25,9 +25,15 @@
 // V: Support Vector count
 // O: Size of output (for SVM-Regression O == 1)
 
+// Maximum number of kernel values held per chunk during activation
+#define KERNEL_TILE_ELEMENTS 65536
+
 #import "YCSVR.h"
 #import "YCModelKernel.h"
+#import "YCLinearKernel.h"
+#import "YCRBFKernel.h"
 @import YCMatrix;
+@import Accelerate;
 
 @implementation YCSVR
 
@@ -36,20 +42,48 @@
     NSAssert([self.sv count], @"Model not trained");
     NSAssert([matrix rows] == self.inputSize, @"Input size mismatch");
     
-    // 1. Scale input
-    Matrix *scaledInput = matrix;
-    if (self.inputTransform)
-    {
-        scaledInput = [matrix matrixByRowWiseMapUsing:self.inputTransform];
-    }
+    int V = self.sv->columns;
+    int S = matrix->columns;
+    Matrix *output = [Matrix matrixOfRows:1 columns:S];
+    if (S == 0) return output;
     
-    // 2. Calculate kernel
-    Matrix *k = [self.kernel kernelValueForA:self.sv b:scaledInput]; //(NxV)T * NxS = VxS
+    // Input columns are processed in chunks, so that the kernel tile (VxC)
+    // stays bounded; chunks are evaluated concurrently
+    int threads = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+    int chunk = MAX(1, MIN(KERNEL_TILE_ELEMENTS / V, (S + threads - 1) / threads));
+    int chunkCount = (S + chunk - 1) / chunk;
     
-    // 3. Calculate output (algorithm is single output!)
-    Matrix *output = [self.lambda matrixByMultiplyingWithRight:k];
+    Matrix *sv = self.sv;
+    Matrix *lambda = self.lambda;
+    Matrix *inputTransform = self.inputTransform;
+    YCModelKernel *kernel = self.kernel;
+    double b = self.b;
+    double *o = output->matrix;
     
-    [output incrementAll:self.b];
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t c) {
+        @autoreleasepool
+        {
+            NSRange range = NSMakeRange(c * chunk, MIN(chunk, S - (int)c * chunk));
+            
+            // 1. Scale input
+            Matrix *scaledInput = [matrix matrixWithColumnsInRange:range];
+            if (inputTransform)
+            {
+                scaledInput = [scaledInput matrixByRowWiseMapUsing:inputTransform];
+            }
+            
+            // 2. Calculate kernel tile, (NxV)T * NxC = VxC
+            double *k = malloc(V * range.length * sizeof(double));
+            [kernel kernelValueForA:sv b:scaledInput into:k];
+            
+            // 3. Reduce against lambda (algorithm is single output!)
+            double *out = o + range.location;
+            vDSP_vfillD(&b, out, 1, range.length);
+            cblas_dgemv(CblasRowMajor, CblasTrans, V, (int)range.length, 1.0, k,
+                        (int)range.length, lambda->matrix, 1, 1.0, out, 1);
+            free(k);
+        }
+    });
     
     // 4. Reverse-scale output and return
     if (self.outputTransform)
@@ -59,6 +93,70 @@
     return output;
 }
 
+- (void)foldTransforms
+{
+    if (!self.sv) return;
+    
+    // Output: y' = c*y + d => lambda' = c*lambda, b' = c*b + d
+    if (self.outputTransform)
+    {
+        double c = self.outputTransform->matrix[0];
+        double d = self.outputTransform->matrix[1];
+        self.lambda = [self.lambda matrixByMultiplyingWithScalar:c];
+        self.b = c * self.b + d;
+        self.outputTransform = nil;
+    }
+    
+    if (!self.inputTransform) return;
+    
+    int N = self.sv->rows;
+    int V = self.sv->columns;
+    double *transform = self.inputTransform->matrix;
+    
+    if ([self.kernel isMemberOfClass:[YCLinearKernel class]])
+    {
+        // Input: x' = a.*x + b => sv'x' = (diag(a)sv)'x + sv'b
+        Matrix *offset = [self.inputTransform column:1];
+        Matrix *svb = [self.sv matrixByTransposingAndMultiplyingWithRight:offset]; // Vx1
+        self.b += [[self.lambda matrixByMultiplyingWithRight:svb] i:0 j:0];
+        Matrix *sv = [Matrix matrixFromMatrix:self.sv];
+        for (int i=0; i<N; i++)
+        {
+            vDSP_vsmulD(sv->matrix + i * V, 1, &transform[2*i], sv->matrix + i * V, 1, V);
+        }
+        self.sv = sv;
+        self.inputTransform = nil;
+    }
+    else if ([self.kernel isMemberOfClass:[YCRBFKernel class]])
+    {
+        // Input: x' = a.*x + b => |s.*(x' - sv)| = |(s.*a).*(x - (sv - b)./a)|
+        for (int i=0; i<N; i++)
+        {
+            if (transform[2*i] == 0) return;
+        }
+        Matrix *oldScale = self.kernel.properties[@"Scale"];
+        Matrix *scale = [Matrix matrixOfRows:N columns:1];
+        Matrix *sv = [Matrix matrixFromMatrix:self.sv];
+        for (int i=0; i<N; i++)
+        {
+            double a = transform[2*i];
+            double b = -transform[2*i + 1];
+            double ia = 1.0 / a;
+            scale->matrix[i] = oldScale ? oldScale->matrix[i] * a : a;
+            vDSP_vsaddD(sv->matrix + i * V, 1, &b, sv->matrix + i * V, 1, V);
+            vDSP_vsmulD(sv->matrix + i * V, 1, &ia, sv->matrix + i * V, 1, V);
+        }
+        
+        // The kernel is replaced, as it may be shared with other models
+        YCModelKernel *kernel = [[self.kernel class] kernel];
+        kernel.properties = [self.kernel.properties mutableCopy];
+        kernel.properties[@"Scale"] = scale;
+        self.kernel = kernel;
+        self.sv = sv;
+        self.inputTransform = nil;
+    }
+}
+
 - (int)inputSize
 {
     return self.sv.rows;
@@ -0,0 +1,47 @@
+//
+//  YCSecondOrderSMORegressionTrainer.h
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+#import "YCSMORegressionTrainer.h"
+
+/**
+ A variant of the SMO trainer for Support Vector Regression, which solves
+ the ε-SVR dual in its 2S-variable form (one multiplier pair per sample).
+ The working pair is selected through second-order information, as
+ described by Fan, Chen & Lin (2005), and variables that are bound and
+ unlikely to change are periodically removed from the active set
+ (shrinking). The active set is kept as a plain integer index array, and
+ kernel rows are obtained through the receiver's cache.
+ 
+ In addition to those of YCSMORegressionTrainer, the following settings
+ are supported:
+ 
+ - Shrinking:   Whether to periodically shrink the active set (default YES).
+ - Tolerance:   The stopping tolerance on the maximal violating pair gap
+                (default 1E-3).
+ - Iterations:  The maximum number of iterations (default 10000000).
+ 
+ The number of iterations performed is stored in the model statistics
+ under "Iterations".
+ */
+@interface YCSecondOrderSMORegressionTrainer : YCSMORegressionTrainer
+
+@end
@@ -0,0 +1,503 @@
+//
+//  YCSecondOrderSMORegressionTrainer.m
+//  YCML
+//
+//  Created by Ioannis (Yannis) Chatzikonstantinou on 19/10/26.
+//  Copyright © 2026 Ioannis (Yannis) Chatzikonstantinou. All rights reserved.
+//
+// This file is part of YCML.
+//
+// YCML is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// YCML is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with YCML.  If not, see <http://www.gnu.org/licenses/>.
+
+// N: Size of input
+// S: Number of samples
+// V: Support Vector count
+
+// The dual variables are laid out as [α+ (S), α- (S)], with y = +1 for the
+// first half and y = -1 for the second. Variable t refers to sample t % S.
+
+#define TAU 1E-12
+
+#import "YCSecondOrderSMORegressionTrainer.h"
+#import "YCSVR.h"
+#import "YCSMOCache.h"
+@import YCMatrix;
+@import Accelerate;
+
+typedef struct
+{
+    int S;
+    int n;
+    int activeSize;
+    double C;
+    double *alpha;
+    double *G;
+    double *Gbar;
+    double *p;
+    double *QD;
+    signed char *y;
+    int *active;
+} YCSMOState;
+
+static inline BOOL YCIsUpperBound(YCSMOState *st, int t) { return st->alpha[t] >= st->C; }
+static inline BOOL YCIsLowerBound(YCSMOState *st, int t) { return st->alpha[t] <= 0; }
+
+static BOOL YCBeShrunk(YCSMOState *st, int t, double Gmax1, double Gmax2)
+{
+    if (YCIsUpperBound(st, t))
+    {
+        return st->y[t] == 1 ? -st->G[t] > Gmax1 : -st->G[t] > Gmax2;
+    }
+    if (YCIsLowerBound(st, t))
+    {
+        return st->y[t] == 1 ? st->G[t] > Gmax2 : st->G[t] > Gmax1;
+    }
+    return NO;
+}
+
+@implementation YCSecondOrderSMORegressionTrainer
+{
+    Matrix *_samples;
+}
+
+-(id)init
+{
+    if (self = [super init])
+    {
+        self.settings[@"Shrinking"]         = @YES;
+        self.settings[@"Tolerance"]         = @1E-3;
+        self.settings[@"Iterations"]        = @10000000;
+    }
+    return self;
+}
+
+- (void)performTrainingModel:(YCSVR *)model
+                 inputMatrix:(Matrix *)input
+                outputMatrix:(Matrix *)output
+{
+    // Input: NxS, output: 1xS
+    
+    // Step I. Scaling inputs & outputs; determining inverse output scaling matrix
+    YCDomain domain = YCMakeDomain(-1, 1);
+    Matrix *inputTransform  = [input rowWiseMapToDomain:domain basis:MinMax];
+    Matrix *outputTransform = [output rowWiseMapToDomain:domain basis:MinMax];
+    Matrix *invOutTransform = [output rowWiseInverseMapFromDomain:domain basis:MinMax];
+    Matrix *scaledInput     = [input matrixByRowWiseMapUsing:inputTransform];
+    Matrix *scaledOutput    = [output matrixByRowWiseMapUsing:outputTransform];
+    
+    double C                = [self.settings[@"C"] doubleValue];
+    double epsilon          = [self.settings[@"Epsilon"] doubleValue];
+    double tolerance        = [self.settings[@"Tolerance"] doubleValue];
+    BOOL shrinking          = [self.settings[@"Shrinking"] boolValue];
+    long maxIterations      = [self.settings[@"Iterations"] longValue];
+    int N                   = scaledInput.rows;
+    int S                   = scaledInput.columns;
+    int n                   = 2 * S;
+    
+    [self prepareKernelForModel:model];
+    
+    _samples = scaledInput;
+    [self prepareKernelRowsForInput:scaledInput model:model];
+    
+    // Step II. Setting up the dual problem; all multipliers start at zero,
+    // hence the gradient is equal to the linear term
+    YCSMOState st;
+    st.S          = S;
+    st.n          = n;
+    st.activeSize = n;
+    st.C          = C;
+    st.alpha      = calloc(n, sizeof(double));
+    st.G          = malloc(n * sizeof(double));
+    st.Gbar       = calloc(n, sizeof(double));
+    st.p          = malloc(n * sizeof(double));
+    st.QD         = malloc(S * sizeof(double));
+    st.y          = malloc(n * sizeof(signed char));
+    st.active     = malloc(n * sizeof(int));
+    
+    const double *z = scaledOutput->matrix;
+    for (int s=0; s<S; s++)
+    {
+        st.p[s]     = epsilon - z[s];
+        st.p[s + S] = epsilon + z[s];
+        st.y[s]     = 1;
+        st.y[s + S] = -1;
+        st.QD[s]    = [self kernelValueForA:s B:s input:scaledInput model:model
+                                     tickle:NO replace:YES];
+    }
+    memcpy(st.G, st.p, n * sizeof(double));
+    for (int t=0; t<n; t++) st.active[t] = t;
+    
+    // Step III. Optimization loop
+    BOOL unshrunk = NO;
+    long iteration = 0;
+    int counter = MIN(S, 1000) + 1;
+    
+    while (iteration < maxIterations && !self.shouldStop)
+    {
+        if (--counter == 0)
+        {
+            counter = MIN(S, 1000);
+            if (shrinking)
+            {
+                [self shrink:&st tolerance:tolerance unshrunk:&unshrunk model:model];
+            }
+        }
+        
+        int i, j;
+        if ([self selectWorkingSet:&st i:&i j:&j tolerance:tolerance model:model])
+        {
+            // Optimal on the active set; check again on the full set
+            [self reconstructGradient:&st model:model];
+            st.activeSize = n;
+            if ([self selectWorkingSet:&st i:&i j:&j tolerance:tolerance model:model]) break;
+            counter = 1; // Shrink in the next iteration
+        }
+        
+        iteration++;
+        
+        const double *Ki = [self kernelRowForIndex:i % S slot:0 input:scaledInput model:model];
+        const double *Kj = [self kernelRowForIndex:j % S slot:1 input:scaledInput model:model];
+        
+        double oldAlphaI = st.alpha[i];
+        double oldAlphaJ = st.alpha[j];
+        double *alpha = st.alpha;
+        
+        double quad = st.QD[i % S] + st.QD[j % S] - 2.0 * Ki[j % S];
+        if (quad <= 0) quad = TAU;
+        
+        if (st.y[i] != st.y[j])
+        {
+            double delta = (-st.G[i] - st.G[j]) / quad;
+            double diff = alpha[i] - alpha[j];
+            alpha[i] += delta;
+            alpha[j] += delta;
+            if (diff > 0)
+            {
+                if (alpha[j] < 0) { alpha[j] = 0; alpha[i] = diff; }
+            }
+            else
+            {
+                if (alpha[i] < 0) { alpha[i] = 0; alpha[j] = -diff; }
+            }
+            if (diff > 0)
+            {
+                if (alpha[i] > C) { alpha[i] = C; alpha[j] = C - diff; }
+            }
+            else
+            {
+                if (alpha[j] > C) { alpha[j] = C; alpha[i] = C + diff; }
+            }
+        }
+        else
+        {
+            double delta = (st.G[i] - st.G[j]) / quad;
+            double sum = alpha[i] + alpha[j];
+            alpha[i] -= delta;
+            alpha[j] += delta;
+            if (sum > C)
+            {
+                if (alpha[i] > C) { alpha[i] = C; alpha[j] = sum - C; }
+                if (alpha[j] > C) { alpha[j] = C; alpha[i] = sum - C; }
+            }
+            else
+            {
+                if (alpha[j] < 0) { alpha[j] = 0; alpha[i] = sum; }
+                if (alpha[i] < 0) { alpha[i] = 0; alpha[j] = sum; }
+            }
+        }
+        
+        // Gradient update over the active set, G += Q_i Δα_i + Q_j Δα_j
+        [self updateGradient:&st rowI:Ki coefficient:st.y[i] * (alpha[i] - oldAlphaI)
+                        rowJ:Kj coefficient:st.y[j] * (alpha[j] - oldAlphaJ)];
+        
+        // Keep the contribution of multipliers at the upper bound, which
+        // is used for reconstructing the gradient of shrunk variables
+        [self updateGbar:&st index:i wasUpper:oldAlphaI >= C row:Ki];
+        [self updateGbar:&st index:j wasUpper:oldAlphaJ >= C row:Kj];
+    }
+    
+    if (st.activeSize < n)
+    {
+        [self reconstructGradient:&st model:model];
+        st.activeSize = n;
+    }
+    
+    // Step IV. Transferring support vectors and coefficients to model
+    NSMutableIndexSet *svIndexes = [NSMutableIndexSet indexSet];
+    for (int s=0; s<S; s++)
+    {
+        if (st.alpha[s] - st.alpha[s + S] != 0) [svIndexes addIndex:s];
+    }
+    
+    Matrix *sv = [Matrix matrixOfRows:N columns:(int)svIndexes.count];
+    Matrix *l = [Matrix matrixOfRows:1 columns:(int)svIndexes.count];
+    
+    __block int v = 0;
+    [svIndexes enumerateIndexesUsingBlock:^(NSUInteger idx, BOOL * _Nonnull stop) {
+        [sv setColumn:v value:[scaledInput column:(int)idx]];
+        l->matrix[v] = st.alpha[idx] - st.alpha[idx + S];
+        v++;
+    }];
+    
+    model.sv = sv;
+    model.lambda = l;
+    model.b = -[self rho:&st];
+    
+    model.inputTransform = inputTransform;
+    model.outputTransform = invOutTransform;
+    
+    model.statistics[@"Iterations"] = @(iteration);
+    [self storeKernelStatisticsInModel:model];
+    
+    // Cleanup
+    free(st.alpha);
+    free(st.G);
+    free(st.Gbar);
+    free(st.p);
+    free(st.QD);
+    free(st.y);
+    free(st.active);
+    
+    [self clearKernelRows];
+    _samples = nil;
+}
+
+- (void)updateGradient:(YCSMOState *)st
+                  rowI:(const double *)Ki coefficient:(double)ci
+                  rowJ:(const double *)Kj coefficient:(double)cj
+{
+    // The active set is split in chunks that are updated concurrently
+    int S = st->S;
+    int activeSize = st->activeSize;
+    int threads = (int)[[NSProcessInfo processInfo] activeProcessorCount];
+    int chunk = MAX(UPDATE_CHUNK, (activeSize + threads - 1) / threads);
+    int chunkCount = (activeSize + chunk - 1) / chunk;
+    const int *active = st->active;
+    const signed char *y = st->y;
+    double *G = st->G;
+    
+    void (^update)(size_t) = ^(size_t c) {
+        int end = MIN(activeSize, ((int)c + 1) * chunk);
+        for (int k=(int)c * chunk; k<end; k++)
+        {
+            int t = active[k];
+            int s = t % S;
+            G[t] += y[t] * (ci * Ki[s] + cj * Kj[s]);
+        }
+    };
+    
+    if (chunkCount > 1)
+    {
+        dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0),
+                       update);
+    }
+    else
+    {
+        update(0);
+    }
+}
+
+/**
+ Second order working set selection (WSS2). Selects i as the maximal
+ violator in I_up, and j among I_low as the variable that maximizes the
+ decrease of the objective. Returns YES if the active set is optimal
+ within |tolerance|.
+ */
+- (BOOL)selectWorkingSet:(YCSMOState *)st i:(int *)outI j:(int *)outJ
+               tolerance:(double)tolerance model:(YCSVR *)model
+{
+    int S = st->S;
+    double Gmax = -INFINITY;
+    double Gmax2 = -INFINITY;
+    int i = -1;
+    int j = -1;
+    double objMin = INFINITY;
+    
+    for (int k=0; k<st->activeSize; k++)
+    {
+        int t = st->active[k];
+        if (st->y[t] == 1)
+        {
+            if (!YCIsUpperBound(st, t) && -st->G[t] >= Gmax)
+            {
+                Gmax = -st->G[t];
+                i = t;
+            }
+        }
+        else
+        {
+            if (!YCIsLowerBound(st, t) && st->G[t] >= Gmax)
+            {
+                Gmax = st->G[t];
+                i = t;
+            }
+        }
+    }
+    
+    if (i == -1) return YES;
+    
+    const double *Ki = [self kernelRowForIndex:i % S slot:0 input:_samples model:model];
+    double QDi = st->QD[i % S];
+    
+    for (int k=0; k<st->activeSize; k++)
+    {
+        int t = st->active[k];
+        double gradDiff;
+        if (st->y[t] == 1)
+        {
+            if (YCIsLowerBound(st, t)) continue;
+            gradDiff = Gmax + st->G[t];
+            Gmax2 = MAX(Gmax2, st->G[t]);
+        }
+        else
+        {
+            if (YCIsUpperBound(st, t)) continue;
+            gradDiff = Gmax - st->G[t];
+            Gmax2 = MAX(Gmax2, -st->G[t]);
+        }
+        if (gradDiff > 0)
+        {
+            double quad = QDi + st->QD[t % S] - 2.0 * Ki[t % S];
+            double obj = -(gradDiff * gradDiff) / (quad > 0 ? quad : TAU);
+            if (obj <= objMin)
+            {
+                objMin = obj;
+                j = t;
+            }
+        }
+    }
+    
+    if (Gmax + Gmax2 < tolerance || j == -1) return YES;
+    
+    *outI = i;
+    *outJ = j;
+    return NO;
+}
+
+- (void)updateGbar:(YCSMOState *)st index:(int)t wasUpper:(BOOL)wasUpper row:(const double *)K
+{
+    BOOL isUpper = YCIsUpperBound(st, t);
+    if (wasUpper == isUpper) return;
+    
+    // Gbar_k += ±C y_t y_k K(t, k), for both halves of the variables
+    double c = (isUpper ? st->C : -st->C) * st->y[t];
+    cblas_daxpy(st->S, c, K, 1, st->Gbar, 1);
+    cblas_daxpy(st->S, -c, K, 1, st->Gbar + st->S, 1);
+}
+
+- (void)reconstructGradient:(YCSMOState *)st model:(YCSVR *)model
+{
+    if (st->activeSize == st->n) return;
+    
+    int S = st->S;
+    for (int k=st->activeSize; k<st->n; k++)
+    {
+        int t = st->active[k];
+        st->G[t] = st->Gbar[t] + st->p[t];
+    }
+    
+    // Free multipliers are never shrunk, so they are all in the active set
+    for (int k=0; k<st->activeSize; k++)
+    {
+        int f = st->active[k];
+        if (YCIsUpperBound(st, f) || YCIsLowerBound(st, f)) continue;
+        const double *Kf = [self kernelRowForIndex:f % S slot:0 input:_samples model:model];
+        double c = st->y[f] * st->alpha[f];
+        for (int m=st->activeSize; m<st->n; m++)
+        {
+            int t = st->active[m];
+            st->G[t] += st->y[t] * c * Kf[t % S];
+        }
+    }
+}
+
+- (void)shrink:(YCSMOState *)st tolerance:(double)tolerance
+      unshrunk:(BOOL *)unshrunk model:(YCSVR *)model
+{
+    double Gmax1 = -INFINITY; // max { -y_t G_t | t in I_up }
+    double Gmax2 = -INFINITY; // max { y_t G_t | t in I_low }
+    
+    for (int k=0; k<st->activeSize; k++)
+    {
+        int t = st->active[k];
+        if (st->y[t] == 1)
+        {
+            if (!YCIsUpperBound(st, t)) Gmax1 = MAX(Gmax1, -st->G[t]);
+            if (!YCIsLowerBound(st, t)) Gmax2 = MAX(Gmax2, st->G[t]);
+        }
+        else
+        {
+            if (!YCIsUpperBound(st, t)) Gmax2 = MAX(Gmax2, -st->G[t]);
+            if (!YCIsLowerBound(st, t)) Gmax1 = MAX(Gmax1, st->G[t]);
+        }
+    }
+    
+    // Close to the solution, restore the full set once, so that variables
+    // shrunk early on get a chance to move again
+    if (!*unshrunk && Gmax1 + Gmax2 <= tolerance * 10)
+    {
+        *unshrunk = YES;
+        [self reconstructGradient:st model:model];
+        st->activeSize = st->n;
+    }
+    
+    for (int k=0; k<st->activeSize; k++)
+    {
+        if (!YCBeShrunk(st, st->active[k], Gmax1, Gmax2)) continue;
+        st->activeSize--;
+        while (st->activeSize > k)
+        {
+            int last = st->active[st->activeSize];
+            if (!YCBeShrunk(st, last, Gmax1, Gmax2))
+            {
+                st->active[st->activeSize] = st->active[k];
+                st->active[k] = last;
+                break;
+            }
+            st->activeSize--;
+        }
+    }
+}
+
+- (double)rho:(YCSMOState *)st
+{
+    int freeCount = 0;
+    double ub = INFINITY;
+    double lb = -INFINITY;
+    double sumFree = 0;
+    
+    for (int t=0; t<st->n; t++)
+    {
+        double yG = st->y[t] * st->G[t];
+        if (YCIsUpperBound(st, t))
+        {
+            if (st->y[t] == -1) ub = MIN(ub, yG);
+            else lb = MAX(lb, yG);
+        }
+        else if (YCIsLowerBound(st, t))
+        {
+            if (st->y[t] == 1) ub = MIN(ub, yG);
+            else lb = MAX(lb, yG);
+        }
+        else
+        {
+            freeCount++;
+            sumFree += yG;
+        }
+    }
+    
+    return freeCount > 0 ? sumFree / freeCount : (ub + lb) / 2;
+}
+
+@end
@@ -38,12 +38,23 @@ FOUNDATION_EXPORT const unsigned char YCMLVersionString[];
 #import "YCLinRegTrainer.h"
 
 #import "YCSVR.h"
+#import "YCSVR+Reduction.h"
 #import "YCSMORegressionTrainer.h"
+#import "YCSecondOrderSMORegressionTrainer.h"
 #import "YCModelKernel.h"
 #import "YCLinearKernel.h"
 #import "YCRBFKernel.h"
+#import "YCKernelFeatureMap.h"
+#import "YCRandomFourierFeatures.h"
+#import "YCNystromFeatures.h"
+
+#import "YCKernelRidgeModel.h"
+#import "YCKernelRidgeTrainer.h"
 
 #import "YCFFN.h"
+#import "YCFFNPlan.h"
+#import "YCFFN+Pruning.h"
+#import "YCQuantizedModel.h"
 #import "YCELMTrainer.h"
 
 #import "YCDerivativeProblem.h"
@@ -51,6 +62,7 @@ FOUNDATION_EXPORT const unsigned char YCMLVersionString[];
 #import "YCBackPropTrainer.h"
 #import "YCRProp.h"
 #import "YCRpropTrainer.h"
+#import "YCAdamTrainer.h"
 #import "YCSVR.h"
 #import "YCSMORegressionTrainer.h"
 #import "YCRBFNet.h"
@@ -63,6 +75,7 @@ FOUNDATION_EXPORT const unsigned char YCMLVersionString[];
 #import "YCTanhLayer.h"
 #import "YCLinearLayer.h"
 #import "YCReLULayer.h"
+#import "YCBlockSparseMatrix.h"
 
 #import "YCKPM.h"
 #import "YCKPMTrainer.h"
@@ -73,6 +86,11 @@ FOUNDATION_EXPORT const unsigned char YCMLVersionString[];
 
 #import "YCProblem.h"
 #import "YCGradientDescent.h"
+#import "YCStochasticOptimizer.h"
+#import "YCMomentum.h"
+#import "YCAdam.h"
+#import "YCAdamW.h"
+#import "YCLBFGS.h"
 #import "YCPopulationBasedOptimizer.h"
 #import "YCIndividual.h"
 #import "YCNSGAII.h"
@@ -89,6 +107,10 @@ FOUNDATION_EXPORT const unsigned char YCMLVersionString[];
 #import "OrderedDictionary.h"
 #import "YCMissingValue.h"
 #import "NSIndexSet+Sampling.h"
+#import "Matrix+Cholesky.h"
+#import "Matrix+Transform.h"
+#import "YCEpochIterator.h"
+#import "YCSparseMatrix.h"
 
 #import "YCMutableArray.h"
 #import "YCRegressionMetrics.h"
@@ -43,12 +43,27 @@
 /**
  Activates the receiver using the passed matrix.
  
+ Activation is reentrant: it does not modify the receiver, and any scratch
+ space it requires is private to the call. A single model may therefore be
+ activated from multiple threads concurrently, as long as it is not being
+ trained or otherwise modified at the same time. Subclasses must preserve
+ this guarantee.
+ 
  @param matrix The matrix to use as input for the activation.
  
  @return The output matrix resulting from the prediction.
  */
 - (Matrix *)activateWithMatrix:(Matrix *)matrix;
 
+/**
+ Prepares the receiver for inference, by folding its input and output
+ scaling transforms into the model parameters wherever this is possible.
+ Transforms that have been folded are removed from the receiver, so that
+ activation no longer spends a separate pass on them. Predictions are
+ unaffected, up to rounding. The default implementation does nothing.
+ */
+- (void)foldTransforms;
+
 /**
  Returns the receiver's input size.
  */
@@ -45,6 +45,11 @@
             @"You must override %@ in subclass %@", NSStringFromSelector(_cmd), [self class]];
 }
 
+- (void)foldTransforms
+{
+    // Nothing to fold by default
+}
+
 - (int)inputSize
 {
     return 0;
@@ -22,6 +22,7 @@
 
 #import <XCTest/XCTest.h>
 @import YCML;
+@import YCMatrix;
 
 @interface YCMLDataframeTests : XCTestCase
 
@@ -83,6 +84,28 @@
     
 }
 
+- (void)testSparseConversion
+{
+    YCDataframe *frame = [YCDataframe dataframe];
+    [frame addSampleWithData:@{@"Color" : @"Red",   @"Size" : @0.0, @"Weight" : @1.5}];
+    [frame addSampleWithData:@{@"Color" : @"Green", @"Size" : @2.0, @"Weight" : @0.0}];
+    [frame addSampleWithData:@{@"Color" : @"Blue",  @"Size" : @0.0, @"Weight" : @0.0}];
+    [frame addSampleWithData:@{@"Color" : @"Red",   @"Size" : @3.0, @"Weight" : @2.5}];
+    NSArray *conversionArray = [frame conversionArray];
+    
+    Matrix *dense = [frame getMatrixUsingConversionArray:conversionArray];
+    YCSparseMatrix *sparse = [frame getSparseMatrixUsingConversionArray:conversionArray];
+    
+    XCTAssertEqual(sparse.rows, dense.rows);
+    XCTAssertEqual(sparse.columns, dense.columns);
+    XCTAssertEqual(sparse.nonZeroCount, 4 + 2 + 2);
+    XCTAssertEqualObjects([sparse denseMatrix], dense);
+    XCTAssertEqualObjects([[YCSparseMatrix sparseMatrixWithMatrix:dense] denseMatrix], dense);
+    
+    NSIndexSet *columns = [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(1, 2)];
+    XCTAssertEqualObjects([[sparse sparseMatrixWithColumns:columns] denseMatrix], [dense columns:columns]);
+}
+
 - (void)testReplaceRow
 {
 //    YCDataframe *df = [self randomDataframeColumns:5 rows:10];
@@ -195,6 +195,42 @@
     XCTAssertLessThan([result valueAtRow:0 column:0], 0.01);
 }
 
+- (void)testMomentumDescent
+{
+    YCProblemGD *gdProblem = [[YCProblemGD alloc] init];
+    YCOptimizer *gd = [[YCMomentum alloc] initWithProblem:gdProblem];
+    gd.settings[@"Iterations"] = @500;
+    [gd run];
+    Matrix *result = [Matrix matrixOfRows:1 columns:1];
+    [gdProblem evaluate:result parameters:gd.state[@"values"]];
+    XCTAssertLessThan([result valueAtRow:0 column:0], 0.01);
+}
+
+- (void)testAdamDescent
+{
+    YCProblemGD *gdProblem = [[YCProblemGD alloc] init];
+    YCOptimizer *gd = [[YCAdam alloc] initWithProblem:gdProblem];
+    gd.settings[@"Iterations"]    = @1000;
+    gd.settings[@"Learning Rate"] = @0.1;
+    gd.settings[@"Schedule"]      = @"Cosine";
+    [gd run];
+    Matrix *result = [Matrix matrixOfRows:1 columns:1];
+    [gdProblem evaluate:result parameters:gd.state[@"values"]];
+    XCTAssertLessThan([result valueAtRow:0 column:0], 0.01);
+}
+
+- (void)testLBFGSDescent
+{
+    YCProblemGD *gdProblem = [[YCProblemGD alloc] init];
+    YCOptimizer *lbfgs = [[YCLBFGS alloc] initWithProblem:gdProblem];
+    lbfgs.settings[@"Iterations"] = @50;
+    [lbfgs run];
+    Matrix *result = [Matrix matrixOfRows:1 columns:1];
+    [gdProblem evaluate:result parameters:lbfgs.state[@"values"]];
+    XCTAssertLessThan([result valueAtRow:0 column:0], 1E-6);
+    XCTAssertLessThan([lbfgs.state[@"currentIteration"] intValue], 50);
+}
+
 - (void)testNSGAIIZDT1
 {
     YCProblemZDT1 *zdt1 = [[YCProblemZDT1 alloc] init];
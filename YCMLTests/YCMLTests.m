@@ -30,6 +30,34 @@
 // Convenience logging function (without date/object)
 #define CleanLog(FORMAT, ...) fprintf(stderr,"%s\n", [[NSString stringWithFormat:FORMAT, ##__VA_ARGS__] UTF8String]);
 
+// Linear regression trainer using L-BFGS in place of gradient descent
+@interface YCLBFGSLinRegTrainer : YCLinRegTrainer
+
+@end
+
+@implementation YCLBFGSLinRegTrainer
+
++ (Class)optimizerClass
+{
+    return [YCLBFGS class];
+}
+
+@end
+
+// Backprop trainer using L-BFGS in place of gradient descent
+@interface YCLBFGSBackPropTrainer : YCBackPropTrainer
+
+@end
+
+@implementation YCLBFGSBackPropTrainer
+
++ (Class)optimizerClass
+{
+    return [YCLBFGS class];
+}
+
+@end
+
 @interface YCMLTests : XCTestCase
 
 @end
@@ -91,7 +119,85 @@
     // Here test net
     Matrix *actual = [net activateWithMatrix:input];
     
-    XCTAssertEqualObjects(expected, actual, @"Predicted matrix is not equal to expected");
+    XCTAssert([expected isEqualToMatrix:actual tolerance:1E-12], @"Predicted matrix is not equal to expected");
+}
+
+- (void)testFFNFusedForward
+{
+    NSArray *classes = @[[YCLinearLayer class], [YCSigmoidLayer class],
+                         [YCTanhLayer class], [YCReLULayer class]];
+    NSArray *functions = @[^double(double x) { return x; },
+                           ^double(double x) { return 1.0 / (1.0 + exp(-x)); },
+                           ^double(double x) { return tanh(x); },
+                           ^double(double x) { return x < 0 ? 0.0 : x; }];
+    
+    // Enough outputs and samples to span more than one tile
+    Matrix *input = [Matrix uniformRandomRows:7 columns:300 domain:YCMakeDomain(-1, 2)];
+    
+    for (int i=0; i<classes.count; i++)
+    {
+        YCFullyConnectedLayer *layer = [classes[i] layerWithInputSize:7 outputSize:40];
+        layer.weightMatrix = [Matrix uniformRandomRows:7 columns:40 domain:YCMakeDomain(-2, 4)];
+        layer.biasVector = [Matrix uniformRandomRows:40 columns:1 domain:YCMakeDomain(-1, 2)];
+        
+        Matrix *expected = [layer.weightMatrix matrixByTransposingAndMultiplyingWithRight:input];
+        [expected addColumn:layer.biasVector];
+        [expected applyFunction:functions[i]];
+        
+        Matrix *actual = [layer forward:input];
+        
+        XCTAssert([expected isEqualToMatrix:actual tolerance:1E-12],
+                  @"Fused forward output of %@ is not equal to expected", classes[i]);
+        XCTAssert(layer.lastActivation == actual, @"Activation has not been retained");
+    }
+}
+
+- (YCFFN *)randomFFNWithLayers:(NSArray *)layers domain:(YCDomain)domain
+{
+    // Random weights and biases in |domain|, and random scaling transforms
+    YCFFN *model = [[YCFFN alloc] init];
+    model.layers = layers;
+    for (YCFullyConnectedLayer *l in model.layers)
+    {
+        l.weightMatrix = [Matrix uniformRandomRows:l.weightMatrix.rows columns:l.weightMatrix.columns
+                                            domain:domain];
+        l.biasVector = [Matrix uniformRandomRows:l.biasVector.rows columns:1 domain:domain];
+    }
+    model.inputTransform  = [Matrix uniformRandomRows:[layers[0] inputSize] columns:2
+                                               domain:YCMakeDomain(0.5, 1)];
+    model.outputTransform = [Matrix uniformRandomRows:[[layers lastObject] outputSize] columns:2
+                                               domain:YCMakeDomain(0.5, 1)];
+    return model;
+}
+
+- (void)testFFNInferenceActivation
+{
+    YCFFN *net = [self randomFFNWithLayers:@[[YCReLULayer layerWithInputSize:4 outputSize:12],
+                                             [YCTanhLayer layerWithInputSize:12 outputSize:3],
+                                             [YCSigmoidLayer layerWithInputSize:3 outputSize:9],
+                                             [YCLinearLayer layerWithInputSize:9 outputSize:2]]
+                                    domain:YCMakeDomain(-1, 2)];
+    
+    // Sample count that is not a multiple of the chunk size
+    Matrix *input = [Matrix uniformRandomRows:4 columns:613 domain:YCMakeDomain(-1, 2)];
+    
+    Matrix *expected = [input matrixByRowWiseMapUsing:net.inputTransform];
+    for (YCFullyConnectedLayer *l in net.layers)
+    {
+        expected = [l forward:expected];
+        l.lastActivation = nil;
+    }
+    expected = [expected matrixByRowWiseMapUsing:net.outputTransform];
+    
+    Matrix *actual = [net activateWithMatrix:input];
+    XCTAssert([expected isEqualToMatrix:actual tolerance:1E-12], @"Inference output is not equal to expected");
+    XCTAssert([actual isEqualToMatrix:[net activateWithMatrix:input] tolerance:0],
+              @"Repeated inference output is not equal");
+    
+    for (YCFullyConnectedLayer *l in net.layers)
+    {
+        XCTAssertNil(l.lastActivation, @"Inference retained layer activations");
+    }
 }
 
 - (void)testFFNParameterVectorEncoding
@@ -161,6 +267,19 @@
     [self numericalGradientsWithLayers:@[hl1, hl2, hl3, ol]];
 }
 
+- (void)testFFNRegularizedMultiOutputNumericalGradients
+{
+    // Several outputs, L2 and a batch size that does not divide the sample
+    // count, so that every scaling term of the cost is exercised
+    YCFullyConnectedLayer *hl = [YCTanhLayer layerWithInputSize:3 outputSize:4];
+    YCFullyConnectedLayer *ol = [YCLinearLayer layerWithInputSize:4 outputSize:3];
+    hl.L2 = 0.05;
+    ol.L2 = 0.02;
+    Matrix *im = [Matrix uniformRandomRows:3 columns:7 domain:YCMakeDomain(0, 1)];
+    Matrix *om = [Matrix uniformRandomRows:3 columns:7 domain:YCMakeDomain(0, 1)];
+    [self numericalGradientsWithLayers:@[hl, ol] input:im output:om batchSize:3];
+}
+
 - (void)numericalGradientsWithLayers:(NSArray *)layers
 {
     double ia[12] = {0.4084028, 0.14962953, 0.912, 0.877,
@@ -169,7 +288,14 @@
     double oa[4] = {0.1, 0.95, 0.45, 0.21};
     Matrix *im = [Matrix matrixFromArray:ia rows:3 columns:4];
     Matrix *om = [Matrix matrixFromArray:oa rows:1 columns:4];
-    
+    [self numericalGradientsWithLayers:layers input:im output:om batchSize:1];
+}
+
+- (void)numericalGradientsWithLayers:(NSArray *)layers
+                               input:(Matrix *)im
+                              output:(Matrix *)om
+                           batchSize:(int)batchSize
+{
     YCFFN *model = [[YCFFN alloc] init];
     
     model.layers = layers;
@@ -177,6 +303,7 @@
     YCBackPropProblem *prob = [[YCBackPropProblem alloc] initWithInputMatrix:im
                                                                 outputMatrix:om
                                                                        model:model];
+    prob.batchSize = batchSize;
     int parameterCount = 0;
     for (YCFullyConnectedLayer *l in layers)
     {
@@ -208,6 +335,430 @@
     XCTAssert([numericalGradients isEqualToMatrix:theoreticalGradients tolerance:1E-8], @"Matrices are not equal");
 }
 
+- (void)testFFNSinglePrecisionGradients
+{
+    NSArray *layers = @[[YCTanhLayer layerWithInputSize:5 outputSize:8],
+                        [YCReLULayer layerWithInputSize:8 outputSize:6],
+                        [YCSigmoidLayer layerWithInputSize:6 outputSize:4],
+                        [YCLinearLayer layerWithInputSize:4 outputSize:2]];
+    YCFFN *model = [[YCFFN alloc] init];
+    model.layers = layers;
+    Matrix *im = [Matrix uniformRandomRows:5 columns:200 domain:YCMakeDomain(0, 1)];
+    Matrix *om = [Matrix uniformRandomRows:2 columns:200 domain:YCMakeDomain(0, 1)];
+    
+    YCBackPropProblem *prob = [[YCBackPropProblem alloc] initWithInputMatrix:im
+                                                                outputMatrix:om
+                                                                       model:model];
+    prob.batchSize = 64;
+    Matrix *lo     = [Matrix matrixOfRows:prob.parameterCount columns:1 value:-1.0];
+    Matrix *hi     = [Matrix matrixOfRows:prob.parameterCount columns:1 value:1.0];
+    Matrix *params = [Matrix uniformRandomLowerBound:lo upperBound:hi];
+    
+    Matrix *doubleGradients = [Matrix matrixLike:params];
+    [prob derivatives:doubleGradients parameters:params];
+    
+    prob.singlePrecision = YES;
+    Matrix *singleGradients = [Matrix matrixLike:params];
+    [prob derivatives:singleGradients parameters:params];
+    
+    XCTAssertEqual(prob.doublePrecisionFallbacks, 0);
+    XCTAssert([singleGradients isEqualToMatrix:doubleGradients tolerance:1E-4],
+              @"Single precision gradients differ from double precision ones");
+}
+
+- (void)testFFNCompiledPlan
+{
+    YCFFN *model = [self randomFFNWithLayers:@[[YCTanhLayer layerWithInputSize:6 outputSize:12],
+                                               [YCReLULayer layerWithInputSize:12 outputSize:9],
+                                               [YCSigmoidLayer layerWithInputSize:9 outputSize:5],
+                                               [YCLinearLayer layerWithInputSize:5 outputSize:3]]
+                                      domain:YCMakeDomain(-1, 2)];
+    Matrix *input = [Matrix uniformRandomRows:6 columns:50 domain:YCMakeDomain(-1, 2)];
+    
+    Matrix *expected = [model activateWithMatrix:input];
+    YCFFNPlan *plan  = [model compiledPlan];
+    XCTAssert([[plan activateWithMatrix:input] isEqualToMatrix:expected tolerance:1E-10],
+              @"Plan batch activation differs from model activation");
+    XCTAssertNotNil(model.inputTransform, @"Compiling modified the model");
+    XCTAssertNotNil(model.outputTransform, @"Compiling modified the model");
+    
+    for (int j=0; j<input.columns; j++)
+    {
+        Matrix *sample = [input column:j];
+        Matrix *output = [Matrix matrixOfRows:3 columns:1];
+        [plan activateSample:sample->matrix output:output->matrix];
+        XCTAssert([output isEqualToMatrix:[expected column:j] tolerance:1E-10],
+                  @"Plan single sample activation differs from model activation");
+    }
+}
+
+- (void)testFFNSparseInput
+{
+    YCFFN *model = [[YCFFN alloc] init];
+    model.layers = @[[YCSigmoidLayer layerWithInputSize:40 outputSize:6],
+                     [YCLinearLayer layerWithInputSize:6 outputSize:2]];
+    model.inputTransform  = [Matrix uniformRandomRows:40 columns:2 domain:YCMakeDomain(0.5, 1)];
+    model.outputTransform = [Matrix uniformRandomRows:2 columns:2 domain:YCMakeDomain(0.5, 1)];
+    
+    // One-hot style input: a few non-zero elements per sample
+    Matrix *dense = [Matrix matrixOfRows:40 columns:30];
+    for (int j=0; j<30; j++)
+    {
+        for (int k=0; k<3; k++) [dense i:arc4random_uniform(40) j:j set:1.0];
+    }
+    YCSparseMatrix *sparse = [YCSparseMatrix sparseMatrixWithMatrix:dense];
+    
+    XCTAssert([[model activateWithSparseMatrix:sparse] isEqualToMatrix:[model activateWithMatrix:dense]
+                                                              tolerance:1E-10],
+              @"Sparse activation differs from dense activation");
+    
+    // Gradients, over several batches
+    Matrix *output = [Matrix uniformRandomRows:2 columns:30 domain:YCMakeDomain(0, 1)];
+    YCBackPropProblem *denseProblem  = [[YCBackPropProblem alloc] initWithInputMatrix:dense
+                                                                         outputMatrix:output
+                                                                                model:model];
+    YCBackPropProblem *sparseProblem = [[YCBackPropProblem alloc] initWithSparseInputMatrix:sparse
+                                                                               outputMatrix:output
+                                                                                      model:model];
+    denseProblem.batchSize  = 8;
+    sparseProblem.batchSize = 8;
+    Matrix *lo     = [Matrix matrixOfRows:denseProblem.parameterCount columns:1 value:-1.0];
+    Matrix *hi     = [Matrix matrixOfRows:denseProblem.parameterCount columns:1 value:1.0];
+    Matrix *params = [Matrix uniformRandomLowerBound:lo upperBound:hi];
+    Matrix *denseGradients  = [Matrix matrixLike:params];
+    Matrix *sparseGradients = [Matrix matrixLike:params];
+    [denseProblem derivatives:denseGradients parameters:params];
+    [sparseProblem derivatives:sparseGradients parameters:params];
+    XCTAssert([sparseGradients isEqualToMatrix:denseGradients tolerance:1E-10],
+              @"Sparse gradients differ from dense gradients");
+}
+
+- (void)testFFNSparseWarmStart
+{
+    // The random input transform has offsets, which a sparse input can't keep
+    YCFFN *model = [self randomFFNWithLayers:@[[YCSigmoidLayer layerWithInputSize:40 outputSize:6],
+                                               [YCLinearLayer layerWithInputSize:6 outputSize:2]]
+                                      domain:YCMakeDomain(-1, 2)];
+    Matrix *dense = [Matrix matrixOfRows:40 columns:30];
+    for (int j=0; j<30; j++)
+    {
+        for (int k=0; k<3; k++) [dense i:arc4random_uniform(40) j:j set:1.0];
+    }
+    YCSparseMatrix *sparse = [YCSparseMatrix sparseMatrixWithMatrix:dense];
+    Matrix *expected = [model activateWithMatrix:dense];
+    
+    // A single iteration only sets the initial parameters
+    YCBackPropTrainer *trainer = [YCBackPropTrainer trainer];
+    trainer.settings[@"Warm Start"] = @YES;
+    trainer.settings[@"Iterations"] = @1;
+    [trainer train:model sparseInputMatrix:sparse outputMatrix:expected];
+    
+    Matrix *offsets = [model.inputTransform column:1];
+    XCTAssert(offsets.min == 0 && offsets.max == 0, @"Input transform offsets were kept");
+    XCTAssert([[model activateWithSparseMatrix:sparse] isEqualToMatrix:expected tolerance:1E-10],
+              @"Warm started model activation differs");
+}
+
+- (void)testFFNPruning
+{
+    YCFFN *model = [self randomFFNWithLayers:@[[YCSigmoidLayer layerWithInputSize:40 outputSize:36],
+                                               [YCLinearLayer layerWithInputSize:36 outputSize:3]]
+                                      domain:YCMakeDomain(-1, 2)];
+    Matrix *input = [Matrix uniformRandomRows:40 columns:50 domain:YCMakeDomain(-1, 2)];
+    
+    [model pruneWeightsKeepingFraction:0.25 blockSize:8];
+    YCFullyConnectedLayer *first = model.layers[0];
+    XCTAssertNotNil(first.sparseWeightMatrix, @"Pruned layer was not compressed");
+    XCTAssert(model.weightDensity < 0.35, @"Weight density too high: %f", model.weightDensity);
+    
+    // Reference activation through the dense kernel, with the same pruned weights
+    YCFFN *dense = [model copy];
+    dense.layers = [[NSArray alloc] initWithArray:model.layers copyItems:YES];
+    for (YCFullyConnectedLayer *l in dense.layers)
+    {
+        l.weightMatrix = [l.weightMatrix copy];
+    }
+    Matrix *expected = [dense activateWithMatrix:input];
+    XCTAssert([[model activateWithMatrix:input] isEqualToMatrix:expected tolerance:1E-10],
+              @"Sparse kernel activation differs from dense activation");
+    
+    // Archiving stores the compressed form
+    NSData *sparseData = [NSKeyedArchiver archivedDataWithRootObject:model];
+    NSData *denseData  = [NSKeyedArchiver archivedDataWithRootObject:dense];
+    XCTAssert(sparseData.length < denseData.length, @"Compressed model is not smaller");
+    YCFFN *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:sparseData];
+    XCTAssert([[decoded activateWithMatrix:input] isEqualToMatrix:expected tolerance:1E-10],
+              @"Decoded model activation differs");
+    
+    // Retuning keeps pruned weights at zero
+    Matrix *output = [model activateWithMatrix:input];
+    YCBackPropTrainer *trainer = [YCBackPropTrainer trainer];
+    trainer.settings[@"Iterations"] = @20;
+    Matrix *before = [first.weightMatrix copy];
+    [model retuneWithTrainer:trainer inputMatrix:input outputMatrix:output];
+    Matrix *after = [model.layers[0] weightMatrix];
+    for (int i=0; i<(int)before.count; i++)
+    {
+        if (before->matrix[i] == 0) XCTAssertEqual(after->matrix[i], 0, @"Pruned weight changed");
+    }
+    XCTAssertNotNil([model.layers[0] sparseWeightMatrix], @"Retuned layer was not recompressed");
+    XCTAssertFalse([trainer.settings[@"Warm Start"] boolValue], @"Trainer settings not restored");
+}
+
+- (void)testFoldPrunedFFN
+{
+    YCFFN *model = [self randomFFNWithLayers:@[[YCSigmoidLayer layerWithInputSize:40 outputSize:36],
+                                               [YCLinearLayer layerWithInputSize:36 outputSize:3]]
+                                      domain:YCMakeDomain(-1, 2)];
+    Matrix *input = [Matrix uniformRandomRows:40 columns:50 domain:YCMakeDomain(-1, 2)];
+    
+    [model pruneWeightsKeepingFraction:0.25 blockSize:4];
+    Matrix *expected = [model activateWithMatrix:input];
+    
+    [model foldTransforms];
+    XCTAssertNil(model.inputTransform, @"Input transform was not folded");
+    XCTAssertNil(model.outputTransform, @"Output transform was not folded");
+    for (YCFullyConnectedLayer *l in model.layers)
+    {
+        XCTAssertNotNil(l.sparseWeightMatrix, @"Folded layer was not compressed");
+    }
+    XCTAssert([[model activateWithMatrix:input] isEqualToMatrix:expected tolerance:1E-10],
+              @"Folded pruned model activation differs");
+}
+
+- (void)testQuantizedModel
+{
+    YCFFN *model = [self randomFFNWithLayers:@[[YCTanhLayer layerWithInputSize:30 outputSize:64],
+                                               [YCLinearLayer layerWithInputSize:64 outputSize:2]]
+                                      domain:YCMakeDomain(-0.3, 0.6)];
+    Matrix *calibration = [Matrix uniformRandomRows:30 columns:500 domain:YCMakeDomain(-1, 2)];
+    Matrix *input       = [Matrix uniformRandomRows:30 columns:300 domain:YCMakeDomain(-1, 2)];
+    
+    YCQuantizedModel *quantized = [YCQuantizedModel quantizedModelWithModel:model
+                                                          calibrationMatrix:calibration];
+    NSDictionary *report = [quantized accuracyReportWithModel:model inputMatrix:input];
+    XCTAssert([report[@"Relative RMSE"] doubleValue] < 0.05, @"Quantized FFN error too large: %@", report);
+    XCTAssert(quantized.parameterBytes * 6 < (30 * 64 + 64 * 2) * sizeof(double),
+              @"Quantized model is not smaller");
+    
+    NSData *data = [NSKeyedArchiver archivedDataWithRootObject:quantized];
+    YCQuantizedModel *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+    XCTAssert([[decoded activateWithMatrix:input] isEqualToMatrix:[quantized activateWithMatrix:input]
+                                                        tolerance:0],
+              @"Decoded quantized model activation differs");
+    
+    YCLinRegModel *linReg = [[YCLinRegModel alloc] init];
+    linReg.theta = [Matrix uniformRandomRows:31 columns:2 domain:YCMakeDomain(-1, 2)];
+    linReg.inputTransform = model.inputTransform;
+    quantized = [YCQuantizedModel quantizedModelWithModel:linReg calibrationMatrix:calibration];
+    report = [quantized accuracyReportWithModel:linReg inputMatrix:input];
+    XCTAssert([report[@"Relative RMSE"] doubleValue] < 0.05, @"Quantized linear model error too large: %@",
+              report);
+}
+
+- (void)testELMSequentialUpdate
+{
+    Matrix *input  = [Matrix uniformRandomRows:5 columns:600 domain:YCMakeDomain(-1, 2)];
+    Matrix *output = [Matrix matrixOfRows:1 columns:600];
+    for (int j=0; j<600; j++)
+    {
+        [output i:0 j:j set:sin([input i:0 j:j]) + [input i:1 j:j] * [input i:2 j:j]];
+    }
+    YCELMTrainer *trainer = [YCELMTrainer trainer];
+    trainer.settings[@"Hidden Layer Size"] = @50;
+    trainer.settings[@"Chunk Size"]        = @64;
+    
+    YCFFN *model = (YCFFN *)[trainer train:nil
+                               inputMatrix:[input matrixWithColumnsInRange:NSMakeRange(0, 300)]
+                              outputMatrix:[output matrixWithColumnsInRange:NSMakeRange(0, 300)]];
+    [trainer updateModel:model
+             inputMatrix:[input matrixWithColumnsInRange:NSMakeRange(300, 300)]
+            outputMatrix:[output matrixWithColumnsInRange:NSMakeRange(300, 300)]];
+    XCTAssertEqual(trainer.accumulatedSampleCount, 600);
+    
+    // Reference: one-shot solution over all samples, with the same hidden layer and transforms
+    Matrix *outputTransform = [model.outputTransform matrixByInvertingRowWiseTransform];
+    Matrix *H = [model.layers[0] forward:[input matrixByRowWiseMapUsing:model.inputTransform]];
+    Matrix *T = [output matrixByRowWiseMapUsing:outputTransform];
+    Matrix *A = [Matrix identityOfRows:50 columns:50];
+    [A add:[H matrixByTransposingAndMultiplyingWithLeft:H]];
+    Matrix *expected = [[A pseudoInverse] matrixByMultiplyingWithRight:
+                        [T matrixByTransposingAndMultiplyingWithLeft:H]];
+    XCTAssert([[model.layers[1] weightMatrix] isEqualToMatrix:expected tolerance:1E-6],
+              @"Sequential ELM weights differ from the one-shot solution");
+}
+
+- (void)testELMCholeskySolve
+{
+    // 250 samples in chunks of 64, so that the last, short chunk reuses the
+    // hidden output buffer with a smaller stride
+    Matrix *input  = [Matrix uniformRandomRows:4 columns:250 domain:YCMakeDomain(-1, 2)];
+    Matrix *output = [Matrix uniformRandomRows:2 columns:250 domain:YCMakeDomain(-1, 2)];
+    
+    // A positive C gives a positive definite system, solved through Cholesky.
+    // With C = -1E-4, -1/C exceeds trace(H * H') <= 30 * 250, so the system
+    // is negative definite and the pseudoinverse fallback is taken
+    for (NSNumber *C in @[@100, @-1E-4])
+    {
+        YCELMTrainer *trainer = [YCELMTrainer trainer];
+        trainer.settings[@"Hidden Layer Size"] = @30;
+        trainer.settings[@"Chunk Size"]        = @64;
+        trainer.settings[@"C"]                 = C;
+        YCFFN *model = (YCFFN *)[trainer train:nil inputMatrix:input outputMatrix:output];
+        
+        Matrix *outputTransform = [model.outputTransform matrixByInvertingRowWiseTransform];
+        Matrix *H = [model.layers[0] forward:[input matrixByRowWiseMapUsing:model.inputTransform]];
+        Matrix *T = [output matrixByRowWiseMapUsing:outputTransform];
+        Matrix *A = [Matrix identityOfRows:30 columns:30];
+        [A multiplyWithScalar:1.0 / [C doubleValue]];
+        [A add:[H matrixByTransposingAndMultiplyingWithLeft:H]];
+        Matrix *expected = [[A pseudoInverse] matrixByMultiplyingWithRight:
+                            [T matrixByTransposingAndMultiplyingWithLeft:H]];
+        XCTAssert([[model.layers[1] weightMatrix] isEqualToMatrix:expected tolerance:1E-6],
+                  @"ELM weights differ from the pseudoinverse solution for C = %@", C);
+    }
+}
+
+#pragma mark - Concurrency Tests
+
+- (void)testConcurrentInference
+{
+    Matrix *input = [Matrix uniformRandomRows:5 columns:300 domain:YCMakeDomain(-1, 2)];
+    NSArray *models = [self randomModelsWithInputSize:5];
+    
+    for (YCSupervisedModel *model in models)
+    {
+        Matrix *expected = [model activateWithMatrix:input];
+        __block int failures = 0;
+        dispatch_apply(64, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+            @autoreleasepool
+            {
+                Matrix *actual = [model activateWithMatrix:input];
+                if (![actual isEqualToMatrix:expected tolerance:0])
+                {
+                    @synchronized(self)
+                    {
+                        failures++;
+                    }
+                }
+            }
+        });
+        XCTAssertEqual(failures, 0, @"Concurrent activation of %@ is not equal to serial", [model class]);
+    }
+}
+
+- (NSArray *)randomModelsWithInputSize:(int)inputSize
+{
+    Matrix *inputTransform = [Matrix uniformRandomRows:inputSize columns:2 domain:YCMakeDomain(0.5, 1)];
+    Matrix *outputTransform = [Matrix uniformRandomRows:1 columns:2 domain:YCMakeDomain(0.5, 1)];
+    NSMutableArray *models = [NSMutableArray array];
+    
+    YCFFN *ffn = [self randomFFNWithLayers:@[[YCSigmoidLayer layerWithInputSize:inputSize outputSize:20],
+                                             [YCLinearLayer layerWithInputSize:20 outputSize:1]]
+                                    domain:YCMakeDomain(-1, 2)];
+    ffn.inputTransform = inputTransform;
+    ffn.outputTransform = outputTransform;
+    [models addObject:ffn];
+    
+    YCRBFNet *rbf = [[YCRBFNet alloc] init];
+    rbf.centers = [Matrix uniformRandomRows:inputSize columns:15 domain:YCMakeDomain(-1, 2)];
+    rbf.widths = [Matrix uniformRandomRows:15 columns:1 domain:YCMakeDomain(0.5, 1)];
+    rbf.weights = [Matrix uniformRandomRows:16 columns:1 domain:YCMakeDomain(-1, 2)];
+    rbf.inputTransform = inputTransform;
+    rbf.outputTransform = outputTransform;
+    [models addObject:rbf];
+    
+    YCSVR *svr = [[YCSVR alloc] init];
+    svr.kernel = [[YCRBFKernel alloc] init];
+    svr.sv = [Matrix uniformRandomRows:inputSize columns:25 domain:YCMakeDomain(-1, 2)];
+    svr.lambda = [Matrix uniformRandomRows:1 columns:25 domain:YCMakeDomain(-1, 2)];
+    svr.b = 0.3;
+    svr.inputTransform = inputTransform;
+    svr.outputTransform = outputTransform;
+    [models addObject:svr];
+    
+    YCSVR *linearSVR = [[YCSVR alloc] init];
+    linearSVR.kernel = [[YCLinearKernel alloc] init];
+    linearSVR.sv = svr.sv;
+    linearSVR.lambda = svr.lambda;
+    linearSVR.b = svr.b;
+    linearSVR.inputTransform = inputTransform;
+    linearSVR.outputTransform = outputTransform;
+    [models addObject:linearSVR];
+    
+    YCKPM *kpm = [[YCKPM alloc] init];
+    kpm.prototypes = [Matrix uniformRandomRows:inputSize columns:25 domain:YCMakeDomain(-1, 2)];
+    kpm.targets = [Matrix uniformRandomRows:1 columns:25 domain:YCMakeDomain(-1, 2)];
+    kpm.inputTransform = inputTransform;
+    kpm.outputTransform = outputTransform;
+    [models addObject:kpm];
+    
+    YCLinRegModel *linReg = [[YCLinRegModel alloc] init];
+    linReg.theta = [Matrix uniformRandomRows:inputSize + 1 columns:1 domain:YCMakeDomain(-1, 2)];
+    linReg.inputTransform = inputTransform;
+    linReg.outputTransform = outputTransform;
+    [models addObject:linReg];
+    
+    return models;
+}
+
+- (void)testFoldTransforms
+{
+    Matrix *input = [Matrix uniformRandomRows:5 columns:50 domain:YCMakeDomain(-1, 2)];
+    
+    for (YCSupervisedModel *model in [self randomModelsWithInputSize:5])
+    {
+        Matrix *expected = [model activateWithMatrix:input];
+        [model foldTransforms];
+        Matrix *actual = [model activateWithMatrix:input];
+        XCTAssert([expected isEqualToMatrix:actual tolerance:1E-10],
+                  @"Output of %@ changed after folding transforms", [model class]);
+        XCTAssertNil([model valueForKey:@"outputTransform"],
+                     @"Output transform of %@ was not folded", [model class]);
+    }
+}
+
+#pragma mark - Sampling Tests
+
+- (void)testEpochIterator
+{
+    int S = 103;
+    int B = 10;
+    Matrix *input  = [Matrix matrixOfRows:3 columns:S];
+    Matrix *output = [Matrix matrixOfRows:1 columns:S];
+    for (int j=0; j<S; j++)
+    {
+        for (int i=0; i<3; i++) [input i:i j:j set:j + 1000 * i];
+        [output i:0 j:j set:-j];
+    }
+    
+    YCEpochIterator *iterator = [[YCEpochIterator alloc] initWithMatrices:@[input, output]
+                                                                batchSize:B];
+    XCTAssertEqual(iterator.batchCount, S / B);
+    
+    for (int e=0; e<3; e++)
+    {
+        NSMutableIndexSet *seen = [NSMutableIndexSet indexSet];
+        for (int b=0; b<iterator.batchCount; b++)
+        {
+            NSArray *batch = [iterator nextBatch];
+            Matrix *inputBatch  = batch[0];
+            Matrix *outputBatch = batch[1];
+            XCTAssertEqual(inputBatch.columns, B);
+            for (int j=0; j<B; j++)
+            {
+                int sample = (int)[inputBatch i:0 j:j];
+                XCTAssertFalse([seen containsIndex:sample], @"Sample repeated within epoch");
+                [seen addIndex:sample];
+                XCTAssertEqual([inputBatch i:2 j:j], sample + 2000);
+                XCTAssertEqual([outputBatch i:0 j:j], -sample);
+            }
+        }
+        XCTAssertEqual(iterator.epoch, e + 1);
+        XCTAssertEqual(seen.count, (NSUInteger)(B * iterator.batchCount));
+    }
+}
+
 #pragma mark - SMO Cache Tests
 
 - (void)testLinkedList
@@ -254,115 +805,79 @@
 
 - (void)testSMOCacheStore
 {
-    YCSMOCache *cache = [[YCSMOCache alloc] initWithDatasetSize:100 cacheSize:20];
+    int datasetSize = 100;
+    YCSMOCache *cache = [[YCSMOCache alloc] initWithDatasetSize:datasetSize
+                                                   memoryBudget:20 * datasetSize * sizeof(double)];
+    XCTAssertEqual(cache.rowCapacity, 20, @"Row capacity not derived from the memory budget");
     
-    // Non-diagonal
+    // Rows
     XCTAssertEqual([cache queryI:2 j:5], notIncluded, @"Cache status query error");
+    XCTAssert([cache rowForIndex:2] == NULL, @"Row should not be cached");
     
-    double reference = 7.5;
-    [cache setI:2 j:5 value:reference];
-    double test = [cache getI:2 j:5 tickle:YES];
-    
-    XCTAssertEqual(reference, test, @"Retrieved value not equal to reference");
+    double *row = [cache insertRowForIndex:2];
+    for (int j=0; j<datasetSize; j++) row[j] = 2 * j;
     
     XCTAssertEqual([cache queryI:2 j:5], included, @"Cache status query error");
-    
-    reference = 1.2;
-    [cache setI:3 j:5 value:reference];
-    test = [cache getI:3 j:5 tickle:YES];
-    
-    XCTAssertEqual(reference, test, @"Retrieved value not equal to reference");
-    
-    XCTAssertEqual([cache queryI:3 j:5], included, @"Cache status query error");
+    XCTAssertEqual([cache queryI:5 j:2], included, @"Cache status query error");
+    XCTAssertEqual([cache getI:2 j:5 tickle:YES], 10, @"Retrieved value not equal to reference");
+    XCTAssertEqual([cache getI:5 j:2 tickle:YES], 10, @"Retrieved value not equal to reference");
+    XCTAssertEqual([cache rowForIndex:2][7], 14, @"Retrieved value not equal to reference");
     
     // Diagonal
-    reference = 1.6;
-    [cache setI:3 j:3 value:reference];
-    test = [cache getI:3 j:3 tickle:YES];
-    
-    XCTAssertEqual(reference, test, @"Retrieved value not equal to reference");
-    
+    XCTAssertEqual([cache queryI:3 j:3], notIncluded, @"Cache status query error");
+    [cache setDiagonalValue:1.6 index:3];
     XCTAssertEqual([cache queryI:3 j:3], included, @"Cache status query error");
+    XCTAssertEqual([cache getI:3 j:3 tickle:YES], 1.6, @"Retrieved value not equal to reference");
     
-    // Store several entries
+    // Store many rows; each retained row must hold its own values
     for (int c=0; c<500; c++)
     {
-        int i = arc4random_uniform(100);
-        int j = arc4random_uniform(100);
-        double value = ((double)arc4random() / 0x100000000);
-        
-        [cache setI:i j:j value:value];
-    }
-    
-    int count = 18;
-    Matrix *locations = [Matrix uniformRandomRows:2 columns:count domain:YCMakeDomain(0, count)];
-    
-    for (int c=0; c<count; c++)
-    {
-        int i = (int)[locations i:0 j:c];
-        int j = (int)[locations i:1 j:c];
-        
-        [cache setI:i j:j value:i*j];
+        int i = arc4random_uniform(datasetSize);
+        if ([cache rowForIndex:i]) continue;
+        row = [cache insertRowForIndex:i];
+        for (int j=0; j<datasetSize; j++) row[j] = i * datasetSize + j;
     }
-    
-    for (int c=0; c<count; c++)
+    int cached = 0;
+    for (int i=0; i<datasetSize; i++)
     {
-        int i = (int)[locations i:0 j:c];
-        int j = (int)[locations i:1 j:c];
-        
-        if ([cache queryI:i j:j] == included)
+        const double *stored = [cache rowForIndex:i];
+        if (!stored || i == 2) continue;
+        cached++;
+        for (int j=0; j<datasetSize; j++)
         {
-            XCTAssertEqual([cache getI:i j:j tickle:YES], i*j,
-                           @"Retrieved value not equal to reference");
-            
-        }
-    }
-    
-    locations = [Matrix uniformRandomRows:2 columns:count domain:YCMakeDomain(0, count)];
-    
-    for (int c=0; c<count; c++)
-    {
-        int i = (int)[locations i:0 j:c];
-        int j = (int)[locations i:1 j:c];
-        
-        [cache setI:i j:j value:i*j];
-    }
-    
-    for (int c=0; c<count; c++)
-    {
-        int i = (int)[locations i:0 j:c];
-        int j = (int)[locations i:1 j:c];
-        
-        if ([cache queryI:i j:j] == included)
-        {
-            XCTAssertEqual([cache getI:i j:j tickle:YES], i*j,
-                           @"Retrieved value not equal to reference");
-            
+            XCTAssertEqual(stored[j], i * datasetSize + j, @"Retrieved value not equal to reference");
         }
     }
+    XCTAssertLessThanOrEqual(cached, 20, @"Cache holds more rows than its capacity");
 }
 
-- (void)testSMOCacheQuery
+- (void)testSMOCacheLRU
 {
-    YCSMOCache *cache = [[YCSMOCache alloc] initWithDatasetSize:100 cacheSize:10];
-    [cache setI:2 j:4 value:1];
-    [cache setI:3 j:5 value:1];
+    YCSMOCache *cache = [[YCSMOCache alloc] initWithDatasetSize:100
+                                                   memoryBudget:3 * 100 * sizeof(double)];
+    [cache insertRowForIndex:1];
+    [cache insertRowForIndex:2];
+    [cache insertRowForIndex:3];
+    
+    // Row 1 becomes the most recently used, so row 2 is evicted next
+    [cache tickleRowForIndex:1];
+    [cache insertRowForIndex:4];
+    
+    XCTAssertTrue([cache rowForIndex:1] != NULL);
+    XCTAssertTrue([cache rowForIndex:2] == NULL);
+    XCTAssertTrue([cache rowForIndex:3] != NULL);
+    XCTAssertTrue([cache rowForIndex:4] != NULL);
     
-    // The following are included
-    XCTAssertTrue([cache queryI:2 j:4]);
-    XCTAssertTrue([cache queryI:3 j:5]);
-    XCTAssertTrue([cache queryI:4 j:2]);
-    XCTAssertTrue([cache queryI:5 j:3]);
+    // The following are included through the rows of 1, 3 and 4
+    XCTAssertTrue([cache queryI:1 j:2]);
+    XCTAssertTrue([cache queryI:2 j:3]);
+    XCTAssertTrue([cache queryI:4 j:50]);
     
     // The following are not included
     XCTAssertFalse([cache queryI:2 j:5]);
     XCTAssertFalse([cache queryI:5 j:2]);
-    XCTAssertFalse([cache queryI:3 j:4]);
-    XCTAssertFalse([cache queryI:4 j:3]);
     XCTAssertFalse([cache queryI:2 j:2]);
     XCTAssertFalse([cache queryI:3 j:3]);
-    XCTAssertFalse([cache queryI:4 j:4]);
-    XCTAssertFalse([cache queryI:5 j:5]);
 }
 
 - (void)testKernelCaching
@@ -387,7 +902,8 @@
     
     // Calculate the kernel values using the trainer mechanism
     YCSMORegressionTrainer *trainer = [YCSMORegressionTrainer trainer];
-    trainer.cache = [[YCSMOCache alloc] initWithDatasetSize:inputSize cacheSize:cacheSize];
+    trainer.cache = [[YCSMOCache alloc] initWithDatasetSize:inputSize
+                                               memoryBudget:cacheSize * inputSize * sizeof(double)];
     
     for (int i=0; i<sequenceSize; i++)
     {
@@ -423,7 +939,9 @@
                 double test = [trainer kernelValueForA:a B:b input:input
                                                  model:model tickle:YES replace:YES];
                 double cacheResult = [trainer.cache getI:a j:b tickle:NO];
-                XCTAssertEqual(value, test, @"Values not equal");
+                
+                // Cached rows are computed in one product, which may round differently
+                XCTAssertEqualWithAccuracy(value, test, 1E-12, @"Values not equal");
                 XCTAssertEqual(cacheResult, test, @"Values not equal");
             }
         }
@@ -478,6 +996,82 @@
     XCTAssertEqual([r i:1 j:4], [r14 i:0 j:0]);
 }
 
+- (void)testKernelMatrixValues
+{
+    YCRBFKernel *rbf = [[YCRBFKernel alloc] init];
+    rbf.properties[@"Beta"]  = @2;
+    rbf.properties[@"Scale"] = [Matrix uniformRandomRows:6 columns:1 domain:YCMakeDomain(0.5, 1)];
+    NSArray *kernels = @[[[YCLinearKernel alloc] init], rbf];
+    
+    // Reference values, through explicit loops over the sample elements
+    Matrix *scale = rbf.properties[@"Scale"];
+    NSArray *references = @[^double(Matrix *a, Matrix *b, int i, int j) {
+        double dot = 0;
+        for (int k=0; k<6; k++) dot += [a i:k j:i] * [b i:k j:j];
+        return dot;
+    }, ^double(Matrix *a, Matrix *b, int i, int j) {
+        double sqsum = 0;
+        for (int k=0; k<6; k++)
+        {
+            double d = scale->matrix[k] * ([a i:k j:i] - [b i:k j:j]);
+            sqsum += d * d;
+        }
+        return exp(-sqsum / 4);
+    }];
+    
+    // Spans several output tiles
+    Matrix *a = [Matrix uniformRandomRows:6 columns:300 domain:YCMakeDomain(-1, 2)];
+    Matrix *b = [Matrix uniformRandomRows:6 columns:200 domain:YCMakeDomain(-1, 2)];
+    for (int k=0; k<kernels.count; k++)
+    {
+        YCModelKernel *kernel = kernels[k];
+        double (^reference)(Matrix *, Matrix *, int, int) = references[k];
+        Matrix *values = [Matrix matrixOfRows:300 columns:200];
+        [kernel kernelValueForA:a b:b into:values->matrix];
+        for (int i=0; i<300; i++)
+        {
+            for (int j=0; j<200; j++)
+            {
+                XCTAssertEqualWithAccuracy([values i:i j:j], reference(a, b, i, j), 1E-12,
+                                           @"Kernel matrix values differ for %@", [kernel class]);
+            }
+        }
+        
+        Matrix *row = [Matrix matrixOfRows:300 columns:1];
+        for (int j=0; j<200; j+=37)
+        {
+            Matrix *vector = [b column:j];
+            [kernel kernelValuesForA:a vector:vector->matrix into:row->matrix];
+            XCTAssert([[values column:j] isEqualToMatrix:row tolerance:1E-12],
+                      @"Kernel matrix values differ for %@", [kernel class]);
+        }
+    }
+}
+
+- (void)testKernelRowValues
+{
+    YCRBFKernel *rbf = [[YCRBFKernel alloc] init];
+    rbf.properties[@"Beta"]  = @2;
+    rbf.properties[@"Scale"] = [Matrix uniformRandomRows:6 columns:1 domain:YCMakeDomain(0.5, 1)];
+    NSArray *kernels = @[[[YCLinearKernel alloc] init], rbf];
+    
+    Matrix *a = [Matrix uniformRandomRows:6 columns:40 domain:YCMakeDomain(-1, 2)];
+    Matrix *b = [Matrix uniformRandomRows:6 columns:1 domain:YCMakeDomain(-1, 2)];
+    for (YCModelKernel *kernel in kernels)
+    {
+        Matrix *expected = [kernel kernelValueForA:a b:b];
+        Matrix *values   = [Matrix matrixOfRows:40 columns:1];
+        [kernel kernelValuesForA:a vector:b->matrix into:values->matrix];
+        XCTAssert([values isEqualToMatrix:expected tolerance:1E-12],
+                  @"Kernel row values differ for %@", [kernel class]);
+        
+        Matrix *aVector = [a column:7];
+        XCTAssertEqualWithAccuracy([kernel kernelValueForVector:aVector->matrix vector:b->matrix length:6],
+                                   [expected i:7 j:0], 1E-12,
+                                   @"Single kernel value differs for %@", [kernel class]);
+    }
+}
+
 - (void)testSVMAndSMOOutput
 {
     YCSVR *model         = [YCSVR model];
@@ -501,6 +1095,82 @@
     XCTAssertEqualWithAccuracy(0.3, y, 1E-8);
 }
 
+- (void)testKernelFeatureMaps
+{
+    YCRBFKernel *kernel = [[YCRBFKernel alloc] init];
+    kernel.properties[@"Beta"] = @1.5;
+    Matrix *a = [Matrix uniformRandomRows:4 columns:30 domain:YCMakeDomain(-1, 2)];
+    Matrix *b = [Matrix uniformRandomRows:4 columns:20 domain:YCMakeDomain(-1, 2)];
+    Matrix *expected = [kernel kernelValueForA:a b:b];
+    
+    // Random Fourier Features converge at a rate of 1/sqrt(D)
+    YCKernelFeatureMap *fourier = [kernel randomFourierFeatureMapWithInputSize:4 featureCount:20000];
+    XCTAssertEqual(fourier.featureCount, 20000);
+    Matrix *approximation = [[fourier featuresForMatrix:a] matrixByTransposingAndMultiplyingWithRight:
+                             [fourier featuresForMatrix:b]];
+    Matrix *difference = [approximation matrixBySubtracting:expected];
+    XCTAssertLessThan(sqrt([difference dotWith:difference] / (30 * 20)), 0.03);
+    
+    // With the samples themselves as landmarks, Nyström is exact on them
+    YCKernelFeatureMap *nystrom = [kernel nystromFeatureMapWithLandmarks:b];
+    Matrix *z = [nystrom featuresForMatrix:b];
+    approximation = [z matrixByTransposingAndMultiplyingWithRight:z];
+    XCTAssert([approximation isEqualToMatrix:[kernel kernelValueForA:b b:b] tolerance:1E-6]);
+}
+
+- (void)testKernelRidgeModelCoding
+{
+    Matrix *input  = [Matrix uniformRandomRows:3 columns:200 domain:YCMakeDomain(-1, 2)];
+    Matrix *output = [Matrix uniformRandomRows:2 columns:200 domain:YCMakeDomain(-1, 2)];
+    
+    for (NSString *approximation in @[@"Fourier", @"Nystrom"])
+    {
+        YCKernelRidgeTrainer *trainer      = [YCKernelRidgeTrainer trainer];
+        trainer.settings[@"Approximation"] = approximation;
+        trainer.settings[@"Features"]      = @50;
+        YCKernelRidgeModel *model = (YCKernelRidgeModel *)[trainer train:nil inputMatrix:input
+                                                              outputMatrix:output];
+        Matrix *expected = [model activateWithMatrix:input];
+        
+        NSData *data = [NSKeyedArchiver archivedDataWithRootObject:model];
+        YCKernelRidgeModel *decoded = [NSKeyedUnarchiver unarchiveObjectWithData:data];
+        XCTAssert([[decoded activateWithMatrix:input] isEqualToMatrix:expected tolerance:1E-12],
+                  @"Decoded %@ model activation differs", approximation);
+        
+        YCKernelRidgeModel *copied = [model copy];
+        XCTAssert(copied.weights != model.weights, @"Copied weights are shared");
+        XCTAssert([[copied activateWithMatrix:input] isEqualToMatrix:expected tolerance:0],
+                  @"Copied %@ model activation differs", approximation);
+    }
+}
+
+- (void)testSVRBlockedActivation
+{
+    YCSVR *model         = [YCSVR model];
+    model.kernel         = [[YCRBFKernel alloc] init];
+    model.sv             = [Matrix uniformRandomRows:3 columns:40 domain:YCMakeDomain(-1, 2)];
+    model.lambda         = [Matrix uniformRandomRows:1 columns:40 domain:YCMakeDomain(-1, 2)];
+    model.b              = 0.3;
+    model.inputTransform = [Matrix matrixFromNSArray:@[@0.5, @0.1,
+                                                       @2.0, @-0.2,
+                                                       @1.0, @0.0] rows:3 columns:2];
+    
+    // Spans several chunks of the kernel tile
+    Matrix *input = [Matrix uniformRandomRows:3 columns:5000 domain:YCMakeDomain(-2, 4)];
+    
+    Matrix *scaled   = [input matrixByRowWiseMapUsing:model.inputTransform];
+    Matrix *k        = [model.kernel kernelValueForA:model.sv b:scaled];
+    Matrix *expected = [model.lambda matrixByMultiplyingWithRight:k];
+    [expected incrementAll:model.b];
+    
+    Matrix *prediction = [model activateWithMatrix:input];
+    XCTAssertEqual(prediction.columns, 5000);
+    for (int j=0; j<5000; j++)
+    {
+        XCTAssertEqualWithAccuracy([prediction i:0 j:j], [expected i:0 j:j], 1E-10);
+    }
+}
+
 - (void)testSMOStep
 {
     YCSVR *model         = [YCSVR model];
@@ -540,6 +1210,225 @@
     NSLog(@"%@", prediction);
 }
 
+- (void)testSMOOutputUpdate
+{
+    YCSVR *model            = [YCSVR model];
+    model.kernel            = [[YCRBFKernel alloc] init];
+    Matrix *input           = [Matrix uniformRandomRows:3 columns:50 domain:YCMakeDomain(-1, 2)];
+    Matrix *output          = [Matrix uniformRandomRows:1 columns:50 domain:YCMakeDomain(-1, 2)];
+    Matrix *lambdas         = [Matrix matrixOfRows:1 columns:50];
+    Matrix *previousOutputs = [Matrix matrixOfRows:1 columns:50];
+    Matrix *lastModified    = [Matrix matrixOfRows:1 columns:50];
+    
+    YCSMORegressionTrainer *trainer = [YCSMORegressionTrainer trainer];
+    [trainer prepareKernelRowsForInput:input model:model];
+    
+    double bias = 0.0;
+    int steps = 0;
+    for (int i=0; i<200; i++)
+    {
+        int i1 = arc4random_uniform(50);
+        int i2 = arc4random_uniform(50);
+        if (![trainer step:model input:input output:output lambdas:lambdas previousOutputs:nil
+              lastModified:nil i1:i1 i2:i2 bias:&bias epsilon:0.1 C:1.0 tickleCache:YES]) continue;
+        
+        steps++;
+        [trainer updateOutputs:previousOutputs lastModified:lastModified input:input model:model];
+    }
+    XCTAssertGreaterThan(steps, 0);
+    
+    // Compare against full recalculation
+    for (int k=0; k<50; k++)
+    {
+        double o = [trainer outputForModel:model input:input lambdas:lambdas previousOutputs:nil
+                              lastModified:nil exampleIndex:k bias:0 tickleCache:NO];
+        XCTAssertEqualWithAccuracy([previousOutputs i:0 j:k], o, 1E-9);
+    }
+    
+    [trainer clearKernelRows];
+}
+
+- (void)testSecondOrderSMO
+{
+    Matrix *input  = [Matrix uniformRandomRows:2 columns:60 domain:YCMakeDomain(-1, 2)];
+    Matrix *output = [Matrix matrixOfRows:1 columns:60];
+    for (int j=0; j<60; j++)
+    {
+        [output i:0 j:j set:sin(2 * [input i:0 j:j]) + 0.5 * [input i:1 j:j]];
+    }
+    
+    YCSecondOrderSMORegressionTrainer *trainer = [YCSecondOrderSMORegressionTrainer trainer];
+    trainer.settings[@"Kernel"]    = @"RBF";
+    trainer.settings[@"C"]         = @10.0;
+    trainer.settings[@"Epsilon"]   = @0.01;
+    trainer.settings[@"Tolerance"] = @1E-6;
+    YCSVR *shrunk = (YCSVR *)[trainer train:nil inputMatrix:input outputMatrix:output];
+    
+    trainer.settings[@"Shrinking"]     = @NO;
+    trainer.settings[@"Disable Cache"] = @YES;
+    YCSVR *full = (YCSVR *)[trainer train:nil inputMatrix:input outputMatrix:output];
+    
+    XCTAssertGreaterThan([shrunk.statistics[@"Iterations"] intValue], 0);
+    
+    Matrix *a = [shrunk activateWithMatrix:input];
+    Matrix *b = [full activateWithMatrix:input];
+    for (int j=0; j<60; j++)
+    {
+        XCTAssertEqualWithAccuracy([a i:0 j:j], [b i:0 j:j], 1E-3);
+        XCTAssertEqualWithAccuracy([a i:0 j:j], [output i:0 j:j], 0.2);
+    }
+}
+
+- (void)testSVReduction
+{
+    Matrix *input  = [Matrix uniformRandomRows:1 columns:150 domain:YCMakeDomain(-2, 4)];
+    Matrix *output = [input matrixByApplyingFunction:^double(double value) { return sin(value); }];
+    
+    YCSecondOrderSMORegressionTrainer *trainer = [YCSecondOrderSMORegressionTrainer trainer];
+    trainer.settings[@"Kernel"]  = @"RBF";
+    trainer.settings[@"C"]       = @1.0;
+    trainer.settings[@"Epsilon"] = @0.001;
+    YCSVR *model = (YCSVR *)[trainer train:nil inputMatrix:input outputMatrix:output];
+    
+    YCSVR *reduced = [model reducedModelWithTolerance:0.01 inputMatrix:input];
+    XCTAssertLessThan(reduced.sv.columns, model.sv.columns);
+    XCTAssertEqual([reduced.statistics[@"Support Vectors"] intValue], reduced.sv.columns);
+    XCTAssertLessThanOrEqual([reduced.statistics[@"Reduction Error"] doubleValue], 0.01 + 1E-9);
+    
+    Matrix *a = [model activateWithMatrix:input];
+    Matrix *b = [reduced activateWithMatrix:input];
+    Matrix *difference = [a matrixBySubtracting:b];
+    XCTAssertLessThanOrEqual(sqrt([difference dotWith:difference] / 150), 0.01 + 1E-9);
+    
+    // A tolerance above the whole decision function still keeps one vector
+    YCSVR *loose = [model reducedModelWithTolerance:100 inputMatrix:input];
+    XCTAssertEqual(loose.sv.columns, 1);
+    XCTAssertEqual(loose.lambda.columns, 1);
+    XCTAssertEqual([loose activateWithMatrix:input].columns, 150);
+    
+    // Linear decision functions reduce exactly to a single vector
+    trainer.settings[@"Kernel"] = @"Linear";
+    YCSVR *linear = (YCSVR *)[trainer train:nil inputMatrix:input outputMatrix:output];
+    YCSVR *linearReduced = [linear reducedModelWithTolerance:0];
+    XCTAssertEqual(linearReduced.sv.columns, 1);
+    a = [linear activateWithMatrix:input];
+    b = [linearReduced activateWithMatrix:input];
+    for (int j=0; j<150; j++)
+    {
+        XCTAssertEqualWithAccuracy([a i:0 j:j], [b i:0 j:j], 1E-9);
+    }
+}
+
+- (void)testKernelMatrixModes
+{
+    Matrix *input  = [Matrix uniformRandomRows:3 columns:200 domain:YCMakeDomain(-1, 2)];
+    Matrix *output = [Matrix uniformRandomRows:1 columns:200 domain:YCMakeDomain(-1, 2)];
+    
+    YCSecondOrderSMORegressionTrainer *trainer = [YCSecondOrderSMORegressionTrainer trainer];
+    trainer.settings[@"Kernel"]    = @"RBF";
+    trainer.settings[@"Tolerance"] = @1E-6;
+    YCSVR *precomputed = (YCSVR *)[trainer train:nil inputMatrix:input outputMatrix:output];
+    XCTAssertEqualObjects(precomputed.statistics[@"Kernel Matrix"], @"Precomputed");
+    XCTAssertEqual([precomputed.statistics[@"Kernel Memory"] intValue], 200 * 200 * 8);
+    
+    // A budget of ~10 rows does not fit the kernel matrix
+    trainer.settings[@"Cache Memory"] = @(10 * 200 * 8 / (1024.0 * 1024.0));
+    YCSVR *cached = (YCSVR *)[trainer train:nil inputMatrix:input outputMatrix:output];
+    XCTAssertEqualObjects(cached.statistics[@"Kernel Matrix"], @"Cached");
+    XCTAssertLessThanOrEqual([cached.statistics[@"Kernel Memory"] intValue], 10 * 200 * 8);
+    
+    // The legacy setting counts rows, and overrides the memory budget
+    YCSecondOrderSMORegressionTrainer *legacy = [YCSecondOrderSMORegressionTrainer trainer];
+    legacy.settings[@"Kernel"]     = @"RBF";
+    legacy.settings[@"Cache Size"] = @10;
+    YCSVR *legacyCached = (YCSVR *)[legacy train:nil inputMatrix:input outputMatrix:output];
+    XCTAssertEqualObjects(legacyCached.statistics[@"Kernel Matrix"], @"Cached");
+    XCTAssertLessThanOrEqual([legacyCached.statistics[@"Kernel Memory"] intValue], 10 * 200 * 8);
+    
+    trainer.settings[@"Kernel Matrix"] = @"Precomputed";
+    YCSVR *forced = (YCSVR *)[trainer train:nil inputMatrix:input outputMatrix:output];
+    XCTAssertEqualObjects(forced.statistics[@"Kernel Matrix"], @"Precomputed");
+    
+    Matrix *a = [precomputed activateWithMatrix:input];
+    Matrix *b = [cached activateWithMatrix:input];
+    for (int j=0; j<200; j++)
+    {
+        XCTAssertEqualWithAccuracy([a i:0 j:j], [b i:0 j:j], 1E-4);
+    }
+}
+
+#pragma mark - OLS Tests
+
+- (void)testOLSForwardSelection
+{
+    Matrix *input  = [Matrix uniformRandomRows:1 columns:300 domain:YCMakeDomain(-3, 6)];
+    Matrix *output = [input matrixByApplyingFunction:^double(double value) { return sin(value); }];
+    
+    YCOLSTrainer *trainer                = [YCOLSTrainer trainer];
+    trainer.settings[@"Kernel Width"]    = @1.0;
+    trainer.settings[@"Error Tolerance"] = @1E-4;
+    YCRBFNet *model = (YCRBFNet *)[trainer train:nil inputMatrix:input outputMatrix:output];
+    
+    int regressors = [model.statistics[@"Regressors"] intValue];
+    XCTAssertEqual(regressors, model.centers.columns);
+    XCTAssertLessThan(regressors, 100);
+    XCTAssertLessThanOrEqual([model.statistics[@"Error"] doubleValue], 1E-4);
+    
+    Matrix *difference = [[model activateWithMatrix:input] matrixBySubtracting:output];
+    XCTAssertLessThan(sqrt([difference dotWith:difference] / 300), 0.02);
+}
+
+- (void)testOLSCandidatePool
+{
+    Matrix *input  = [Matrix uniformRandomRows:1 columns:300 domain:YCMakeDomain(-3, 6)];
+    Matrix *output = [input matrixByApplyingFunction:^double(double value) { return sin(value); }];
+    
+    for (NSString *selection in @[@"Random", @"KMeans", @"Sobol", @"Halton"])
+    {
+        for (Class trainerClass in @[[YCOLSTrainer class], [YCOLSPRESSTrainer class]])
+        {
+            YCOLSTrainer *trainer                    = [trainerClass trainer];
+            trainer.settings[@"Kernel Width"]        = @1.0;
+            trainer.settings[@"Error Tolerance"]     = @1E-4;
+            trainer.settings[@"Candidates"]          = @60;
+            trainer.settings[@"Candidate Selection"] = selection;
+            YCRBFNet *model = (YCRBFNet *)[trainer train:nil inputMatrix:input outputMatrix:output];
+            
+            XCTAssertEqual([model.statistics[@"Candidates"] intValue], 60);
+            XCTAssertLessThanOrEqual(model.centers.columns, 60);
+            
+            Matrix *difference = [[model activateWithMatrix:input] matrixBySubtracting:output];
+            XCTAssertLessThan(sqrt([difference dotWith:difference] / 300), 0.05, @"%@", selection);
+        }
+    }
+}
+
+- (void)testQuasiRandomSequenceBounds
+{
+    // Bounds exclude zero, so that unwritten elements fall outside them
+    double lowerArray[3] = {-2, 10, 3};
+    double upperArray[3] = {1, 20, 3.5};
+    Matrix *lower = [Matrix matrixFromArray:lowerArray rows:3 columns:1];
+    Matrix *upper = [Matrix matrixFromArray:upperArray rows:3 columns:1];
+    
+    Matrix *sobol  = [Matrix sobolSequenceLowerBound:lower upperBound:upper count:64];
+    Matrix *halton = [Matrix haltonSequenceWithLowerBound:lower upperBound:upper count:64];
+    
+    for (Matrix *sequence in @[sobol, halton])
+    {
+        XCTAssertEqual(sequence.rows, 3);
+        XCTAssertEqual(sequence.columns, 64);
+        for (int i=0; i<3; i++)
+        {
+            for (int j=0; j<64; j++)
+            {
+                XCTAssertGreaterThanOrEqual([sequence i:i j:j], lowerArray[i]);
+                XCTAssertLessThanOrEqual([sequence i:i j:j], upperArray[i]);
+            }
+        }
+    }
+}
+
 #pragma mark - Cross-Validation Tests
 
 - (void)testLinearModel
@@ -551,6 +1440,14 @@
     [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:8.0];
 }
 
+- (void)testLBFGSLinearModel
+{
+    YCLinRegTrainer *trainer = [YCLBFGSLinRegTrainer trainer];
+    trainer.settings[@"L2"]                = @0.001;
+    trainer.settings[@"Iterations"]        = @200;
+    [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:8.0];
+}
+
 - (void)testKPM
 {
     YCKPMTrainer *trainer = [YCKPMTrainer trainer];
@@ -566,6 +1463,15 @@
     [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:8.0];
 }
 
+- (void)testLBFGSBackPropHousing
+{
+    YCBackPropTrainer *trainer              = [YCLBFGSBackPropTrainer trainer];
+    trainer.settings[@"Hidden Layer Size"]  = @8;
+    trainer.settings[@"L2"]                 = @0.0001;
+    trainer.settings[@"Iterations"]         = @300;
+    [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:8.0];
+}
+
 - (void)testBackPropHousing
 {
     YCBackPropTrainer *trainer              = [YCBackPropTrainer trainer];
@@ -577,6 +1483,18 @@
     [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:6.0];
 }
 
+- (void)testSinglePrecisionBackPropHousing
+{
+    YCBackPropTrainer *trainer              = [YCBackPropTrainer trainer];
+    trainer.settings[@"Hidden Layer Size"]  = @8;
+    trainer.settings[@"L2"]                 = @0.0001;
+    trainer.settings[@"Iterations"]         = @1500;
+    trainer.settings[@"Alpha"]              = @0.5;
+    trainer.settings[@"Single Precision"]   = @YES;
+    
+    [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:6.0];
+}
+
 - (void)testRPropHousing
 {
     YCRpropTrainer *trainer                 = [YCRpropTrainer trainer];
@@ -597,6 +1515,14 @@
     [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:6.5];
 }
 
+- (void)testAdamHousing
+{
+    YCAdamTrainer *trainer                  = [YCAdamTrainer trainer];
+    trainer.settings[@"Hidden Layer Size"]  = @8;
+    trainer.settings[@"L2"]                 = @1E-5;
+    [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:6.0];
+}
+
 - (void)testLinearSVRSMOHousing
 {
     YCSMORegressionTrainer *trainer         = [YCSMORegressionTrainer trainer];
@@ -613,6 +1539,34 @@
     [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:6.0];
 }
 
+- (void)testRBFSVRSecondOrderSMOHousing
+{
+    YCSMORegressionTrainer *trainer         = [YCSecondOrderSMORegressionTrainer trainer];
+    trainer.settings[@"Kernel"]             = @"RBF";
+    trainer.settings[@"C"]                  = @0.5;
+    trainer.settings[@"Beta"]               = @1.4;
+    [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:6.0];
+}
+
+- (void)testFourierKernelRidgeHousing
+{
+    YCKernelRidgeTrainer *trainer      = [YCKernelRidgeTrainer trainer];
+    trainer.settings[@"Beta"]          = @1.4;
+    trainer.settings[@"Features"]      = @400;
+    trainer.settings[@"Lambda"]        = @1E-2;
+    [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:8.0];
+}
+
+- (void)testNystromKernelRidgeHousing
+{
+    YCKernelRidgeTrainer *trainer      = [YCKernelRidgeTrainer trainer];
+    trainer.settings[@"Beta"]          = @1.4;
+    trainer.settings[@"Approximation"] = @"Nystrom";
+    trainer.settings[@"Features"]      = @200;
+    trainer.settings[@"Lambda"]        = @1E-2;
+    [self testWithTrainer:trainer dataset:@"housing" dependentVariableLabel:@"MedV" rmse:8.0];
+}
+
 - (void)testRBFNetOLSHousing
 {
     YCOLSTrainer *trainer                   = [YCOLSTrainer trainer];
@@ -234,7 +234,7 @@ static void sobol_destroy(soboldata *sd);
         
         for (int i = 0; i < s->sdim; ++i)
         {
-            result->matrix[i * n + j] = lower->matrix[i] + x[i] * range->matrix[i];
+            result->matrix[i * n + j - 1] = lower->matrix[i] + x[i] * range->matrix[i];
         }
     }
     if (s) {
@@ -254,7 +254,7 @@ static void sobol_destroy(soboldata *sd);
     
     Matrix *result = [HaltonInterface sampleWithDimension:lower.rows count:count];
     
-    [result multiplyColumn:upper];
+    [result multiplyColumn:[upper matrixBySubtracting:lower]];
     [result addColumn:lower];
     
     return result;